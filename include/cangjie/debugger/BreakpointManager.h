@@ -25,6 +25,8 @@
 #ifndef CANGJIE_DEBUGGER_BREAKPOINT_MANAGER_H
 #define CANGJIE_DEBUGGER_BREAKPOINT_MANAGER_H
 
+#include <atomic>
+#include <cstdint>
 #include <string>
 #include <map>
 #include <memory>
@@ -36,6 +38,7 @@
 #include <request.pb.h>
 
 #include "ProtoConverter.h"
+#include "ConditionCompiler.h"
 
 namespace cangjie {
 namespace debugger {
@@ -99,6 +102,20 @@ public:
     BreakpointManager();
     ~BreakpointManager();
 
+    /**
+     * @brief 记录事件线程取出了一个 LLDB 事件，返回该事件的序号（可在事件线程上调用）
+     *
+     * 断点回调在取出停止事件时（DoOnRemoval）于取事件的线程上执行，WaitForEvent 返回时回调已经结束。
+     */
+    uint64_t NotePulledEvent();
+
+    /**
+     * @brief 释放在序号为 event_sequence 的事件被取出之前替换或删除的条件程序
+     *
+     * 在请求线程处理完该事件后调用：替换时可能仍在执行的回调只属于该事件或更早取出的事件，此时都已结束。
+     */
+    void ReleaseRetiredConditions(uint64_t event_sequence);
+
     // Set LLDB target for breakpoint operations
     void SetTarget(const lldb::SBTarget &target);
 
@@ -273,12 +290,44 @@ private:
 
     static Cangjie::Debugger::BreakpointType DetectBreakpointType(const lldbprotobuf::AddBreakpointRequest& request);
 
+    /**
+     * @brief 为断点设置条件
+     *
+     * 简单条件编译为字节码，由断点回调直接读取内存和寄存器求值，条件为假时自动继续运行；
+     * 其他条件交给 SBBreakpoint::SetCondition。设置了忽略计数时 LLDB 在回调之前扣减计数，
+     * 与条件为真才计数的语义不同，因此也交给 SetCondition。
+     */
+    void ApplyCondition(lldb::SBBreakpoint& lldb_bp, const std::string& condition, uint32_t ignore_count);
+
+    /**
+     * @brief 移除断点上的编译条件
+     */
+    void RemoveCompiledCondition(int64_t breakpoint_id);
+
+    // 将条件程序移入待释放列表
+    void RetireCondition(std::unique_ptr<Cangjie::Debugger::ConditionProgram> program);
+
+    static bool CompiledConditionCallback(void* baton, lldb::SBProcess& process, lldb::SBThread& thread,
+                                          lldb::SBBreakpointLocation& location);
+
     // Legacy structures (for backward compatibility)
     using BreakpointKey = std::pair<std::string, int>;
     std::map<BreakpointKey, std::unique_ptr<BreakpointInfo>> legacy_breakpoints_;
 
     // New structures
     std::map<int64_t, std::unique_ptr<BreakpointInfo>> breakpoints_by_id_;
+
+    // 编译后的断点条件，作为回调 baton 使用
+    std::map<int64_t, std::unique_ptr<Cangjie::Debugger::ConditionProgram>> compiled_conditions_;
+    // 被替换或删除的条件程序：回调在事件线程取出停止事件时执行，替换时可能仍在使用，
+    // 记录替换时已取出的事件数量，其后取出的事件处理完毕后才释放
+    struct RetiredCondition {
+        uint64_t pulled_events = 0;
+        std::unique_ptr<Cangjie::Debugger::ConditionProgram> program;
+    };
+    std::vector<RetiredCondition> retired_conditions_;
+    // 事件线程已取出的事件数量
+    std::atomic<uint64_t> pulled_events_{0};
     lldb::SBTarget target_;
 };
 
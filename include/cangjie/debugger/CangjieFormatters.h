@@ -0,0 +1,93 @@
+/*
+ * Copyright 2025 LinQingYing. and contributors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * The use of this source code is governed by the Apache License 2.0,
+ * which allows users to freely use, modify, and distribute the code,
+ * provided they adhere to the terms of the license.
+ *
+ * The software is provided "as-is", and the authors are not responsible for
+ * any damages or issues arising from its use.
+ *
+ */
+
+
+#ifndef CANGJIE_DEBUGGER_CANGJIE_FORMATTERS_H
+#define CANGJIE_DEBUGGER_CANGJIE_FORMATTERS_H
+
+#include <cstdint>
+#include <optional>
+#include <string>
+
+#include <lldb/API/LLDB.h>
+
+namespace Cangjie {
+namespace Debugger {
+
+/**
+ * @brief Cangjie 核心运行时类型的原生格式化器
+ *
+ * 针对 String、Array<T>、ArrayList<T> 和 HashMap<K,V>，直接读取对象的头部字段（长度、起始下标）
+ * 和数据区，而不经过 LLDB 的通用子变量枚举和摘要提供器：
+ *   - 摘要只基于有界前缀计算，代价与对象大小无关；
+ *   - Array / ArrayList 的元素按 基址 + 下标 * 元素大小 随机访问。
+ *
+ * 字段按标准库成员名从调试信息中解析，布局与预期不符时返回空，调用方退回到通用路径。
+ */
+class CangjieFormatters {
+public:
+    /**
+     * @brief 可识别的运行时类型
+     */
+    enum class Kind : uint8_t {
+        NONE,
+        STRING,
+        ARRAY,
+        ARRAY_LIST,
+        HASH_MAP
+    };
+
+    /**
+     * @brief 连续存储的元素序列
+     */
+    struct Sequence {
+        lldb::addr_t base = LLDB_INVALID_ADDRESS;   // 第 0 个元素的地址（长度为 0 时无效）
+        uint64_t length = 0;
+        uint32_t stride = 0;                        // 元素大小
+        lldb::SBType element_type;
+    };
+
+    /**
+     * @brief 按类型名识别运行时类型（忽略包名前缀和泛型参数）
+     */
+    static Kind Classify(const char* type_name);
+
+    /**
+     * @brief 解析 Array / ArrayList 的元素存储
+     * @return 不是可识别的序列类型或布局不符时返回空
+     */
+    static std::optional<Sequence> ResolveSequence(lldb::SBValue& value);
+
+    /**
+     * @brief 计算摘要
+     * @param max_length 摘要最大长度；字符串只读取这么多字节
+     * @return 不是可识别的类型或布局不符时返回空
+     */
+    static std::optional<std::string> Summarize(lldb::SBValue& value, lldb::SBProcess& process, uint32_t max_length);
+};
+
+} // namespace Debugger
+} // namespace Cangjie
+
+#endif // CANGJIE_DEBUGGER_CANGJIE_FORMATTERS_H
@@ -0,0 +1,147 @@
+/*
+ * Copyright 2025 LinQingYing. and contributors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * The use of this source code is governed by the Apache License 2.0,
+ * which allows users to freely use, modify, and distribute the code,
+ * provided they adhere to the terms of the license.
+ *
+ * The software is provided "as-is", and the authors are not responsible for
+ * any damages or issues arising from its use.
+ *
+ */
+
+#ifndef CANGJIE_DEBUGGER_CONDITION_COMPILER_H
+#define CANGJIE_DEBUGGER_CONDITION_COMPILER_H
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <lldb/API/LLDB.h>
+
+#include "cangjie/debugger/PrimitiveArrayDecoder.h"
+#include "cangjie/debugger/VariablePathParser.h"
+
+namespace Cangjie {
+namespace Debugger {
+
+/**
+ * @brief 条件字节码操作码
+ */
+enum class ConditionOpcode : uint8_t {
+    LOAD_VARIABLE,  // 压入变量值，operand 为变量路径下标
+    LOAD_REGISTER,  // 压入寄存器值，operand 为寄存器名下标
+    LOAD_CONSTANT,  // 压入常量，operand 为常量下标
+    COMPARE,        // 弹出两个标量、压入比较结果，operand 为 ConditionComparison
+    TEST,           // 检查栈顶为 Bool，否则求值失败
+    NOT,            // 栈顶 Bool 取反，非 Bool 时求值失败
+    JUMP_IF_FALSE,  // 栈顶为假时保留栈顶并跳转到 operand，否则弹出栈顶
+    JUMP_IF_TRUE    // 栈顶为真时保留栈顶并跳转到 operand，否则弹出栈顶
+};
+
+/**
+ * @brief 比较运算符
+ */
+enum class ConditionComparison : uint8_t {
+    EQ,
+    NE,
+    LT,
+    LE,
+    GT,
+    GE
+};
+
+/**
+ * @brief 单条字节码指令
+ */
+struct ConditionInstruction {
+    ConditionOpcode opcode;
+    uint32_t operand = 0;
+};
+
+/**
+ * @brief 求值栈上的标量，按 encoding 解释对应字段
+ */
+struct ConditionScalar {
+    PrimitiveEncoding encoding = PrimitiveEncoding::SIGNED;
+    int64_t signed_value = 0;     // SIGNED
+    uint64_t unsigned_value = 0;  // UNSIGNED、BOOL
+    double float_value = 0.0;     // FLOAT
+};
+
+/**
+ * @brief 编译后的断点条件
+ *
+ * 求值时直接读取变量内存和寄存器，不经过表达式引擎。程序编译后不再修改，
+ * 可以在 LLDB 私有状态线程上的断点回调中并发求值。
+ */
+class ConditionProgram {
+public:
+    /**
+     * @brief 在指定栈帧上求值
+     * @return 条件结果；变量不存在、类型不是基本类型、内存读取失败，或 '!' 与单独的操作数不是 Bool 时
+     *         返回 std::nullopt，调用方应改用表达式引擎求值原始条件
+     */
+    [[nodiscard]] std::optional<bool> Evaluate(lldb::SBProcess& process, lldb::SBFrame& frame) const;
+
+    /**
+     * @brief 原始条件文本
+     */
+    [[nodiscard]] const std::string& GetSource() const {
+        return source_;
+    }
+
+    [[nodiscard]] size_t GetInstructionCount() const {
+        return code_.size();
+    }
+
+private:
+    friend class ConditionCompiler;
+
+    bool LoadValue(lldb::SBProcess& process, lldb::SBValue value, ConditionScalar& out) const;
+
+    std::string source_;
+    std::vector<ConditionInstruction> code_;
+    std::vector<VariablePath> variables_;
+    std::vector<std::string> registers_;
+    std::vector<ConditionScalar> constants_;
+};
+
+/**
+ * @brief 将简单断点条件编译为字节码
+ *
+ * 接受的形式：比较式 "操作数 运算符 操作数"（==、!=、<、<=、>、>=）或单独的 Bool 操作数，
+ * 用 &&、||、! 和括号组合。操作数为变量路径（见 VariablePathParser）、"$寄存器名"，
+ * 或整数、浮点、true/false 常量（可带仓颉类型后缀，如 10u8、1.5f32）。
+ * 其他条件（函数调用、算术运算、字符串等）编译失败，由调用方交给 SBBreakpoint::SetCondition。
+ */
+class ConditionCompiler {
+public:
+    /**
+     * @brief 求值栈深度上限，超过时编译失败
+     */
+    static constexpr uint32_t MAX_STACK_DEPTH = 32;
+
+    /**
+     * @return 条件可编译时返回字节码程序，否则返回 std::nullopt
+     */
+    static std::optional<ConditionProgram> Compile(const std::string& condition);
+};
+
+} // namespace Debugger
+} // namespace Cangjie
+
+#endif // CANGJIE_DEBUGGER_CONDITION_COMPILER_H
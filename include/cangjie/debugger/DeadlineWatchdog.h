@@ -0,0 +1,119 @@
+/*
+ * Copyright 2025 LinQingYing. and contributors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * The use of this source code is governed by the Apache License 2.0,
+ * which allows users to freely use, modify, and distribute the code,
+ * provided they adhere to the terms of the license.
+ *
+ * The software is provided "as-is", and the authors are not responsible for
+ * any damages or issues arising from its use.
+ *
+ */
+
+#ifndef CANGJIE_DEBUGGER_DEADLINE_WATCHDOG_H
+#define CANGJIE_DEBUGGER_DEADLINE_WATCHDOG_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace Cangjie {
+namespace Debugger {
+
+/**
+ * @brief 为阻塞调用设置硬截止时间的看门狗
+ *
+ * 请求在事件循环线程中同步执行，循环自身的定时器在调用阻塞期间无法触发；
+ * 看门狗在独立线程中计时，到期后执行回调（如中断目标进程），使阻塞调用返回。
+ * 同一时刻只有一个截止时间生效，再次 Arm 会替换之前的设置。
+ * 后台线程在首次 Arm 时创建，析构时退出。
+ */
+class DeadlineWatchdog {
+public:
+    /**
+     * @brief 作用域内生效的截止时间，离开作用域时自动解除
+     */
+    class Scope {
+    public:
+        Scope(DeadlineWatchdog& watchdog, std::chrono::milliseconds timeout, std::function<void()> on_expired)
+            : watchdog_(watchdog), ticket_(watchdog.Arm(timeout, std::move(on_expired))) {
+        }
+
+        ~Scope() {
+            watchdog_.Disarm(ticket_);
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+        /**
+         * @brief 截止时间是否已到期并执行过回调
+         */
+        [[nodiscard]] bool Expired() const {
+            return watchdog_.HasExpired(ticket_);
+        }
+
+    private:
+        DeadlineWatchdog& watchdog_;
+        uint64_t ticket_;
+    };
+
+    DeadlineWatchdog() = default;
+    ~DeadlineWatchdog();
+
+    DeadlineWatchdog(const DeadlineWatchdog&) = delete;
+    DeadlineWatchdog& operator=(const DeadlineWatchdog&) = delete;
+
+    /**
+     * @brief 设置截止时间
+     * @param timeout 距现在的时长
+     * @param on_expired 到期回调，在看门狗线程中执行
+     * @return 用于 Disarm 的票据
+     */
+    uint64_t Arm(std::chrono::milliseconds timeout, std::function<void()> on_expired);
+
+    /**
+     * @brief 解除截止时间；票据已被替换或已到期时无操作
+     */
+    void Disarm(uint64_t ticket);
+
+    /**
+     * @brief 票据对应的截止时间是否已到期
+     */
+    [[nodiscard]] bool HasExpired(uint64_t ticket) const;
+
+private:
+    void Loop();
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::thread thread_;
+    bool stopping_ = false;
+
+    uint64_t next_ticket_ = 0;
+    uint64_t armed_ticket_ = 0;      // 0 表示未设置
+    uint64_t expired_ticket_ = 0;    // 最近一次到期的票据
+    std::chrono::steady_clock::time_point deadline_;
+    std::function<void()> on_expired_;
+};
+
+} // namespace Debugger
+} // namespace Cangjie
+
+#endif // CANGJIE_DEBUGGER_DEADLINE_WATCHDOG_H
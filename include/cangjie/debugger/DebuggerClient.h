@@ -26,6 +26,16 @@
 #define CANGJIE_DEBUGGER_DEBUGGER_CLIENT_H
 
 #include "cangjie/debugger/TcpClient.h"
+#include "cangjie/debugger/EventReactor.h"
+#include "cangjie/debugger/LexicalScopeCache.h"
+#include "cangjie/debugger/CangjieFormatters.h"
+#include "cangjie/debugger/DeadlineWatchdog.h"
+#include "cangjie/debugger/PrimitiveArrayDecoder.h"
+#include "cangjie/debugger/StopCache.h"
+#include "cangjie/debugger/StringInternTable.h"
+#include "cangjie/debugger/TypeCache.h"
+#include "cangjie/debugger/VariableHandleTable.h"
+#include "cangjie/debugger/VariablePathParser.h"
 
 #include "model.pb.h"
 
@@ -33,10 +43,13 @@
 #include <vector>
 #include <unordered_map>
 
+#include <chrono>
 #include <functional>
 #include <thread>
 #include <atomic>
 #include <optional>
+#include <memory>
+#include <mutex>
 #include <request.pb.h>
 
 #include "ProtoConverter.h"
@@ -44,6 +57,7 @@
 
 
 #include <lldb/API/LLDB.h>
+#include <google/protobuf/arena.h>
 
 
 namespace Cangjie {
@@ -55,6 +69,12 @@ namespace Cangjie {
 
             ~DebuggerClient();
 
+            /**
+             * @brief 设置同时持有 SBValue 的最大变量数量，超出后按 LRU 淘汰，再次访问时按来源重建
+             * @param max_live_variables 最大数量，0 表示不限制
+             */
+            void SetMaxLiveVariables(size_t max_live_variables);
+
             bool SendInitializedEvent(
 
                 uint64_t capabilities = 0
@@ -169,6 +189,13 @@ namespace Cangjie {
             bool SendRemoveBreakpointResponse(bool success = true, const std::string &error_message = "",
                                               const std::optional<uint64_t> hash = std::nullopt) const;
 
+            bool SendConfigureStopSnapshotResponse(bool success, uint32_t max_frames, uint32_t max_locals,
+                                                   const std::string &error_message = "",
+                                                   const std::optional<uint64_t> hash = std::nullopt) const;
+
+            bool SendConfigureStringInternResponse(bool success, const std::string &error_message = "",
+                                                   const std::optional<uint64_t> hash = std::nullopt) const;
+
             // Console Command Response
             bool SendExecuteCommandResponse(
                 bool success,
@@ -207,6 +234,13 @@ namespace Cangjie {
                 lldb::SBThread &stopped_thread,
                 lldb::SBFrame &current_frame) const;
 
+            /**
+             * @brief 填充停止快照：所有线程、停止线程的顶层栈帧和第 0 帧的第一页变量
+             * @param snapshot 待填充的快照
+             * @param stopped_thread 停止线程
+             */
+            void FillStopSnapshot(lldbprotobuf::StopSnapshot *snapshot, lldb::SBThread &stopped_thread) const;
+
             /**
              * @brief 发送进程状态变更事件（运行状态）
              */
@@ -276,7 +310,76 @@ namespace Cangjie {
             );
 
         private:
+            /**
+             * @brief 处理单个请求（跳过空请求）
+             * @param request 接收到的请求
+             * @param request_handler 自定义处理器，为空时使用 HandleRequest
+             * @return 返回 false 表示应退出消息循环
+             */
+            bool DispatchRequest(
+                const lldbprotobuf::Request &request,
+                const std::function<bool(const lldbprotobuf::Request &)> &request_handler
+            );
+
+            /**
+             * @brief 基于事件循环的消息循环（仅 Linux），socket 可读时接收并分发请求
+             */
+            void RunReactorLoop(
+                const std::function<bool(const lldbprotobuf::Request &)> &request_handler
+            );
+
+            /**
+             * @brief 在请求线程上处理事件线程排队的 LLDB 事件（无事件循环时使用）
+             */
+            void DrainQueuedEvents();
+
+            /**
+             * @brief 在请求线程上处理事件线程取出的事件，之后释放不再被断点回调使用的条件程序
+             * @param sequence 事件线程取出该事件时得到的序号
+             */
+            void HandlePulledEvent(uint64_t sequence, lldb::SBEvent &event);
+
             TcpClient &tcp_client_;
+
+            // 响应 arena：大列表响应直接在 arena 上构造，每个顶层请求处理完后整体重置
+            mutable std::vector<char> response_arena_block_;
+            mutable std::unique_ptr<google::protobuf::Arena> response_arena_;
+
+            /**
+             * @brief 在响应 arena 上分配 Response 并设置请求 hash
+             * @param hash 请求哈希
+             * @return arena 上的 Response，在当前顶层请求处理完之前有效
+             */
+            lldbprotobuf::Response *NewArenaResponse(std::optional<uint64_t> hash) const;
+
+            /**
+             * @brief 发送 arena 上的 Response（同步序列化，发送后即可重置 arena）
+             */
+            bool SendArenaResponse(lldbprotobuf::Response *response) const;
+
+            // 批量请求执行期间的子响应收集器；为空时响应直接发送
+            mutable lldbprotobuf::BatchResponse *batch_sink_ = nullptr;
+
+            /**
+             * @brief 投递响应：批量执行期间追加到 batch_sink_，否则直接发送
+             * @param response 待投递的响应，追加到批量响应时其内容会被移走
+             */
+            bool DeliverResponse(lldbprotobuf::Response &response) const;
+
+            /**
+             * @brief 将响应中的类型名、文件路径、模块名和符号名替换为驻留字符串引用
+             *
+             * 仅处理变量、子变量、栈帧和反汇编响应；首次出现的字符串定义追加到该响应的 interned_strings。
+             */
+            void InternResponseStrings(lldbprotobuf::Response &response) const;
+
+            /**
+             * @brief 重置响应 arena，一次性释放本次请求分配的所有消息
+             */
+            void ResetResponseArena() const;
+
+            // 事件循环：统一调度请求、LLDB 事件和定时器
+            EventReactor reactor_;
             // std::unique_ptr<IPCManager> io_manager_;
 
             // 管理器类 - 使用旧命名空间
@@ -304,10 +407,84 @@ namespace Cangjie {
             // 专用事件监听器
             mutable lldb::SBListener event_listener_;
 
-            // 变量ID到LLDB SBValue的映射表
-            // Key: 变量ID (uint64_t，基于thread_id+frame_index+current_time的哈希)
-            // Value: LLDB SBValue对象
-            mutable std::unordered_map<uint64_t, lldb::SBValue> variable_id_map_;
+            // 用于唤醒阻塞在 WaitForEvent 上的事件线程
+            lldb::SBBroadcaster wakeup_broadcaster_;
+
+            // 无事件循环时由事件线程排队、请求线程处理的 LLDB 事件，保证事件与请求串行执行
+            std::mutex queued_events_mutex_;
+            std::vector<std::pair<uint64_t, lldb::SBEvent>> queued_events_;
+
+            // 以停止 ID 为作用域的查询结果缓存
+            mutable StopCache stop_cache_;
+
+            // 跨停止复用的变量类型描述缓存
+            mutable TypeCache type_cache_;
+
+            // 按函数缓存的词法块地址范围，用于 in_scope_only 过滤
+            mutable LexicalScopeCache scope_cache_;
+
+            // 表达式求值的硬截止时间，到期后中断进程
+            mutable DeadlineWatchdog evaluate_watchdog_;
+
+            /**
+             * @brief 客户端订阅的监视表达式，每次停止时自动求值并随停止事件推送
+             */
+            struct WatchSubscription {
+                uint32_t watch_id = 0;
+                std::string expression;
+                // 订阅时解析一次的变量路径，非简单路径时为空
+                std::optional<VariablePath> path;
+                // 上次停止时的显示内容，用于标记变化；首次求值前为空
+                std::optional<std::string> last_fingerprint;
+            };
+
+            // 监视订阅（请求处理写入，停止事件处理读取）
+            mutable std::mutex watch_mutex_;
+            mutable std::vector<WatchSubscription> watch_subscriptions_;
+            mutable lldbprotobuf::EvaluateRequest watch_options_;
+
+            /**
+             * @brief 输出类型描述缓存的命中率统计
+             */
+            void LogTypeCacheStats() const;
+
+            /**
+             * @brief 获取当前停止 ID
+             * @return 进程处于停止状态时返回 SBProcess::GetStopID()，否则返回空（不使用缓存）
+             */
+            std::optional<uint32_t> CurrentStopId() const;
+
+            // 每次停止时建立的 thread_id -> SBThread 索引，替代按下标遍历全部线程
+            mutable std::mutex thread_index_mutex_;
+            mutable std::unordered_map<uint64_t, lldb::SBThread> thread_index_;
+            mutable std::optional<uint32_t> thread_index_stop_id_;
+
+            /**
+             * @brief 按线程 ID 查找线程
+             *
+             * 进程停止时使用按停止 ID 建立的索引，O(1) 查找；
+             * 进程未停止时线程列表随时变化，直接调用 SBProcess::GetThreadByID()。
+             * @param thread_id 线程 ID（SBThread::GetThreadID()）
+             * @return 找到返回有效线程，否则返回无效的 SBThread
+             */
+            lldb::SBThread FindThreadById(uint64_t thread_id) const;
+
+            /**
+             * @brief 停止 ID 变化时重建线程索引（进程停止时调用）
+             */
+            void RefreshThreadIndex() const;
+
+            // 停止快照配置（由客户端通过 ConfigureStopSnapshotRequest 启用，事件线程读取）
+            std::atomic<bool> stop_snapshot_enabled_{false};
+            std::atomic<uint32_t> stop_snapshot_max_frames_{0};
+            std::atomic<uint32_t> stop_snapshot_max_locals_{0};
+
+            // 响应字符串驻留（由客户端通过 ConfigureStringInternRequest 启用，仅请求线程访问）
+            bool string_intern_enabled_ = false;
+            mutable StringInternTable string_intern_;
+
+            // 变量句柄表：变量ID即句柄，同一逻辑变量（线程、帧、变量路径）跨停止复用同一句柄
+            mutable VariableHandleTable variable_handles_;
 
             // 模块跟踪 - 用于检测模块卸载
             // Key: 模块UUID字符串, Value: 模块信息
@@ -370,16 +547,178 @@ namespace Cangjie {
 
             /**
              * @brief 为变量分配ID并存储映射
+             *
+             * ID 由 (线程ID, 帧 CFA 与函数地址, 变量表达式路径) 确定性地计算，
+             * 同一逻辑变量在不同停止之间保持相同的 ID。
              * @param thread_id 线程ID
-             * @param frame_index 帧索引
+             * @param frame_index 帧索引（帧 CFA 不可用时使用）
              * @param sb_value LLDB变量对象
+             * @param path 变量路径，为空时使用 SBValue::GetExpressionPath()
              * @return 分配的变量ID
              */
-            uint64_t AllocateVariableId(uint64_t thread_id, uint32_t frame_index, lldb::SBValue &sb_value) const;
+            uint64_t AllocateVariableId(uint64_t thread_id, uint32_t frame_index, lldb::SBValue &sb_value,
+                                        const std::string &path = "") const;
+
+            /**
+             * @brief 按变量 ID 记录值指纹，并据此设置 value_did_change
+             *
+             * 指纹由 SBValue 的原始字节、未截断的摘要和错误信息计算，与 value 中的显示文本无关，
+             * 因此不同取值路径（不同截断长度、批量解码）得到的指纹一致。
+             * @return 相对于之前停止的变化情况
+             */
+            ValueChange TrackValueChange(uint64_t variable_id, lldb::SBValue &sb_value,
+                                         lldbprotobuf::Value *value) const;
 
             /**
-             * @brief 从变量映射中清理失效的SBValue对象
-             * @return 清理的变量数量
+             * @brief 按批量读取的元素原始字节记录值指纹，与 SBValue 路径得到的指纹一致
+             * @param data 元素在目标字节序下的原始字节
+             * @param size 元素字节数
+             */
+            ValueChange TrackValueChange(uint64_t variable_id, const uint8_t *data, size_t size,
+                                         lldbprotobuf::Value *value) const;
+
+            /**
+             * @brief 将求值请求中的超时、线程策略、JIT 与出错回退选项映射为 SBExpressionOptions
+             */
+            static lldb::SBExpressionOptions CreateExpressionOptions(const lldbprotobuf::EvaluateRequest &req);
+
+            /**
+             * @brief 解析求值所用的线程与栈帧
+             * @param has_thread_id 为 false 时使用当前选中线程
+             * @return 失败时返回 false，error_message 为错误原因
+             */
+            bool ResolveEvaluationFrame(bool has_thread_id, uint64_t thread_id, uint32_t frame_index,
+                                        lldb::SBThread &thread, lldb::SBFrame &frame,
+                                        std::string &error_message) const;
+
+            /**
+             * @brief 在指定帧中求值一个表达式，结果（或错误状态）写入 evaluate_resp
+             *
+             * 简单变量路径直接在帧中查找，其余表达式交给表达式引擎并受硬截止时间约束。
+             * 调用方根据 evaluation_path 决定是否需要使值缓存失效。
+             * @param options 求值选项，expression、thread_id、frame_index 字段不使用
+             * @param parsed_path 预先解析的变量路径，为空时按 expression 现场解析
+             * @param inline_value_length 大于 0 时在结果中附带变量值，字符串按该长度截断
+             * @param transient_failure 非空时写入失败是否为暂时性的（超过截止时间、超时或被中断），
+             *                          此类结果不应缓存
+             * @return 求值成功返回 true
+             */
+            bool EvaluateInFrame(lldb::SBThread &thread, lldb::SBFrame &frame, const std::string &expression,
+                                 const lldbprotobuf::EvaluateRequest &options,
+                                 lldbprotobuf::EvaluateResponse *evaluate_resp,
+                                 const std::optional<VariablePath> *parsed_path = nullptr,
+                                 uint32_t inline_value_length = 0,
+                                 bool *transient_failure = nullptr) const;
+
+            /**
+             * @brief 在停止线程的栈顶帧中求值全部监视订阅，结果及变化标记写入停止详情
+             *
+             * 与 EvaluateRequest 共用 evaluate_watchdog_ 和摘要时间预算，只能在处理请求的线程
+             * （事件循环或消息循环）上调用，与请求串行执行；事件线程从不直接处理事件。
+             */
+            void FillWatchResults(lldbprotobuf::ProcessStoppedDetails *details, lldb::SBThread &stopped_thread) const;
+
+            /**
+             * @brief 在当前请求的摘要时间预算内创建变量值
+             *
+             * 预算用完或调用方要求延迟时不调用摘要提供器，摘要以占位符返回并标记为延迟，
+             * 避免单个病态值（超长字符串、大型集合）阻塞请求线程。
+             * @param defer_summary 为 true 时无论预算如何都不计算摘要
+             */
+            lldbprotobuf::Value CreateBudgetedValue(lldb::SBValue &sb_value, uint64_t variable_id,
+                                                    uint32_t max_string_length, bool defer_summary = false) const;
+
+            // 当前顶层请求已消耗的取值（含摘要）时间，每个请求处理完后清零
+            mutable std::chrono::steady_clock::duration summary_time_spent_{};
+
+            // 子变量列表（响应顶层或某个变量下展开的一层）
+            using VariableList = google::protobuf::RepeatedPtrField<lldbprotobuf::Variable>;
+
+            /**
+             * @brief 变量 ID 的帧作用域，同一帧中的变量共享，批量分配时只需解析一次
+             */
+            struct VariableScope {
+                uint64_t thread_id = 0;
+                uint32_t frame_index = 0;
+                uint64_t frame_key = 0;      // CFA，不可用时为帧索引
+                uint64_t frame_cfa = 0;
+                uint64_t function_key = 0;   // 函数起始地址
+            };
+
+            /**
+             * @brief 解析变量所在帧的作用域
+             */
+            VariableScope ResolveVariableScope(uint64_t thread_id, uint32_t frame_index, lldb::SBFrame frame) const;
+
+            /**
+             * @brief 按作用域与变量路径获取变量 ID
+             * @param sb_value 变量对象；传入无效值时只登记来源，首次访问时按路径重建
+             */
+            uint64_t AcquireVariableId(const VariableScope &scope, const std::string &path,
+                                       const lldb::SBValue &sb_value) const;
+
+            /**
+             * @brief 获取变量的一个子变量窗口 [offset, offset + count)
+             *
+             * 依次尝试 Cangjie 序列的布局直读、基本类型连续数组的批量读取，最后逐个获取子变量。
+             * @return 父变量的子元素总数
+             */
+            uint32_t FillChildWindow(lldb::SBValue &parent_value, uint32_t offset, uint32_t count,
+                                     uint64_t thread_id, uint32_t frame_index, VariableList *children) const;
+
+            /**
+             * @brief 将已获取的子变量按广度优先内联展开到 max_depth 层
+             *
+             * 每层最多 max_children 个子变量（0 使用默认值），整个响应受节点总数预算限制；
+             * 未展开或未取全的层可通过 total_children 识别并继续分页获取。
+             * @param max_depth 总层数，roots 本身为第 1 层
+             */
+            void ExpandChildSubtrees(VariableList *roots, uint32_t max_depth, uint32_t max_children,
+                                     uint64_t thread_id, uint32_t frame_index) const;
+
+            /**
+             * @brief 基本类型连续数组的子变量批量读取
+             *
+             * 子变量窗口足够大、元素为连续存储的基本类型时，用一次 ReadMemory 读取整个窗口并在本地解码，
+             * 子变量附带内联值，不再逐元素访问 LLDB。
+             * @return 不满足条件时返回 false 且不修改响应，调用方应逐个获取子变量
+             */
+            bool FillContiguousArrayChildren(lldb::SBValue &parent_value, uint32_t start_idx, uint32_t end_idx,
+                                             uint64_t thread_id, uint32_t frame_index,
+                                             VariableList *children) const;
+
+            /**
+             * @brief 按运行时布局直接读取 Cangjie 序列（Array/ArrayList）的子变量窗口
+             *
+             * 元素按 "基址 + 下标 * 步长" 直接定位，支持任意窗口的随机访问；
+             * 基本类型元素一次读取整个窗口，其他元素按地址构造后逐个转换。
+             * @return 无法构造元素时返回 false，调用方应回退到通用路径
+             */
+            bool FillSequenceChildren(lldb::SBValue &parent_value, const CangjieFormatters::Sequence &sequence,
+                                      uint32_t start_idx, uint32_t end_idx, uint64_t thread_id,
+                                      uint32_t frame_index,
+                                      VariableList *children) const;
+
+            /**
+             * @brief 将一段已定位的基本类型元素一次读入并解码为子变量
+             * @param first 窗口首元素，用于生成所有元素共享的类型信息
+             * @return 读取或解码失败时返回 false 且不修改响应
+             */
+            bool FillDecodedChildren(const std::string &parent_path, const VariableScope &scope,
+                                     lldb::SBValue &first, const PrimitiveLayout &layout,
+                                     lldb::addr_t window_base, uint32_t start_idx, uint32_t count,
+                                     VariableList *children) const;
+
+            /**
+             * @brief 按句柄保存的来源（线程、帧、变量路径）重建被淘汰或已过期的变量
+             * @param variable_id 变量ID
+             * @return 重建成功返回有效的 SBValue，并写回句柄表
+             */
+            lldb::SBValue RehydrateVariable(uint64_t variable_id) const;
+
+            /**
+             * @brief 释放所有变量句柄
+             * @return 释放的句柄数量
              */
             size_t CleanupInvalidVariables() const;
 
@@ -489,6 +828,15 @@ namespace Cangjie {
             bool HandleRemoveBreakpointRequest(const lldbprotobuf::RemoveBreakpointRequest &req,
                                                const std::optional<uint64_t> hash = std::nullopt) const;
 
+            // ============================================================================
+            // Request Handlers - Session Configuration
+            // ============================================================================
+            bool HandleConfigureStopSnapshotRequest(const lldbprotobuf::ConfigureStopSnapshotRequest &req,
+                                                    const std::optional<uint64_t> hash = std::nullopt);
+
+            bool HandleConfigureStringInternRequest(const lldbprotobuf::ConfigureStringInternRequest &req,
+                                                    const std::optional<uint64_t> hash = std::nullopt);
+
 
             // ============================================================================
             // Request Handlers - Expression Evaluation and Variables
@@ -543,12 +891,21 @@ namespace Cangjie {
             bool HandleSetVariableValueRequest(const lldbprotobuf::SetVariableValueRequest &req,
                                                const std::optional<uint64_t> hash = std::nullopt) const;
 
+            bool HandleGetSummariesRequest(const lldbprotobuf::GetSummariesRequest &req,
+                                           const std::optional<uint64_t> hash = std::nullopt) const;
+
             bool HandleVariablesChildrenRequest(const lldbprotobuf::VariablesChildrenRequest &req,
                                                 const std::optional<uint64_t> hash = std::nullopt) const;
 
             bool HandleEvaluateRequest(const lldbprotobuf::EvaluateRequest &req,
                                        const std::optional<uint64_t> hash = std::nullopt) const;
 
+            bool HandleEvaluateExpressionsRequest(const lldbprotobuf::EvaluateExpressionsRequest &req,
+                                                  const std::optional<uint64_t> hash = std::nullopt) const;
+
+            bool HandleSubscribeWatchesRequest(const lldbprotobuf::SubscribeWatchesRequest &req,
+                                               const std::optional<uint64_t> hash = std::nullopt) const;
+
             bool HandleReadMemoryRequest(const lldbprotobuf::ReadMemoryRequest &req,
                                          const std::optional<uint64_t> hash = std::nullopt) const;
 
@@ -557,6 +914,31 @@ namespace Cangjie {
 
             bool HandleDisassembleRequest(const lldbprotobuf::DisassembleRequest &req,
                                           const std::optional<uint64_t> hash = std::nullopt) const;
+
+            // ============================================================================
+            // Request Handlers - Batch
+            // ============================================================================
+
+            /**
+             * @brief 按顺序执行批量子请求，并把所有子响应汇总为一个 BatchResponse 发送
+             * @param req 批量请求
+             * @param hash 批量请求哈希
+             */
+            bool HandleBatchRequest(const lldbprotobuf::BatchRequest &req,
+                                    const std::optional<uint64_t> hash = std::nullopt);
+
+            /**
+             * @brief 解析子请求的引用并写入子请求的 Id 字段
+             * @param reference 引用
+             * @param batch 已执行子请求的响应
+             * @param entry_index 当前子请求下标
+             * @param sub_request 待填充的子请求
+             * @param error_message 解析失败时的错误信息
+             * @return 解析成功返回 true
+             */
+            bool ResolveBatchReference(const lldbprotobuf::BatchReference &reference,
+                                       const lldbprotobuf::BatchResponse &batch, int entry_index,
+                                       lldbprotobuf::Request &sub_request, std::string &error_message) const;
         };
     } // namespace Debugger
 } // namespace Cangjie
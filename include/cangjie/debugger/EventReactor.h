@@ -0,0 +1,147 @@
+/*
+ * Copyright 2025 LinQingYing. and contributors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * The use of this source code is governed by the Apache License 2.0,
+ * which allows users to freely use, modify, and distribute the code,
+ * provided they adhere to the terms of the license.
+ *
+ * The software is provided "as-is", and the authors are not responsible for
+ * any damages or issues arising from its use.
+ *
+ */
+
+
+#ifndef CANGJIE_DEBUGGER_EVENT_REACTOR_H
+#define CANGJIE_DEBUGGER_EVENT_REACTOR_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace Cangjie {
+namespace Debugger {
+
+/**
+ * @brief 基于就绪通知的事件循环（Linux 下使用 epoll）
+ *
+ * 统一管理 socket 可读事件、定时器（timerfd）和跨线程唤醒（eventfd），
+ * 使请求处理与 LLDB 事件处理在同一个循环线程中串行执行。
+ * 非 Linux 平台不支持，Initialize() 返回 false，调用方应回退到阻塞式循环。
+ *
+ * 除 Post() 和 Stop() 外，其他方法只能在 Run() 之前或循环线程中调用。
+ */
+class EventReactor {
+public:
+    using Callback = std::function<void()>;
+
+    EventReactor();
+    ~EventReactor();
+
+    EventReactor(const EventReactor&) = delete;
+    EventReactor& operator=(const EventReactor&) = delete;
+
+    /**
+     * @brief 当前平台是否支持事件循环
+     */
+    static bool IsSupported();
+
+    /**
+     * @brief 创建 epoll 实例和唤醒用的 eventfd
+     * @return 成功返回 true，初始化后即可接受 Post() 的任务
+     */
+    bool Initialize();
+
+    [[nodiscard]] bool IsInitialized() const;
+
+    /**
+     * @brief 注册文件描述符的可读回调（水平触发）
+     * @param fd 文件描述符
+     * @param on_readable 可读时调用的回调
+     * @return 成功返回 true
+     */
+    bool AddReadable(int fd, Callback on_readable);
+
+    /**
+     * @brief 注销文件描述符
+     */
+    bool RemoveFd(int fd);
+
+    /**
+     * @brief 添加定时器
+     * @param interval 触发间隔
+     * @param on_expired 到期回调
+     * @param repeat 是否周期触发
+     * @return 定时器ID，失败返回 0
+     */
+    uint64_t AddTimer(std::chrono::milliseconds interval, Callback on_expired, bool repeat);
+
+    /**
+     * @brief 取消定时器
+     */
+    bool CancelTimer(uint64_t timer_id);
+
+    /**
+     * @brief 投递任务到循环线程执行（线程安全）
+     * @param task 任务
+     * @return 循环已停止或未初始化时返回 false，调用方需自行处理该任务
+     */
+    bool Post(Callback task);
+
+    /**
+     * @brief 运行事件循环，直到 Stop() 被调用
+     */
+    void Run();
+
+    /**
+     * @brief 请求停止事件循环（线程安全）
+     */
+    void Stop();
+
+private:
+    struct Handler {
+        Callback callback;
+        bool is_timer = false;
+        bool repeat = false;
+        uint64_t timer_id = 0;
+    };
+
+    void Wakeup() const;
+    void DrainPostedTasks();
+    void Close();
+
+    int epoll_fd_;
+    int wakeup_fd_;
+    std::atomic<bool> running_;
+
+    // 跨线程投递的任务队列
+    std::mutex tasks_mutex_;
+    std::vector<Callback> pending_tasks_;
+    bool accepting_tasks_;
+
+    // fd -> 处理器（仅循环线程访问）
+    std::unordered_map<int, Handler> handlers_;
+    // 定时器ID -> timerfd
+    std::unordered_map<uint64_t, int> timers_;
+    uint64_t next_timer_id_;
+};
+
+} // namespace Debugger
+} // namespace Cangjie
+
+#endif // CANGJIE_DEBUGGER_EVENT_REACTOR_H
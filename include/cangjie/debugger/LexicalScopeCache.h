@@ -0,0 +1,118 @@
+/*
+ * Copyright 2025 LinQingYing. and contributors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * The use of this source code is governed by the Apache License 2.0,
+ * which allows users to freely use, modify, and distribute the code,
+ * provided they adhere to the terms of the license.
+ *
+ * The software is provided "as-is", and the authors are not responsible for
+ * any damages or issues arising from its use.
+ *
+ */
+
+#ifndef CANGJIE_DEBUGGER_LEXICAL_SCOPE_CACHE_H
+#define CANGJIE_DEBUGGER_LEXICAL_SCOPE_CACHE_H
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <lldb/API/LLDB.h>
+
+namespace Cangjie {
+namespace Debugger {
+
+/**
+ * @brief 函数词法块地址范围的缓存
+ *
+ * 每个函数首次查询时遍历一次 SBBlock 树，记录各词法块的地址范围及其中声明的局部变量
+ * （按变量名与声明行定位）；之后判断变量是否在作用域内只需检查其所在块是否覆盖 PC。
+ * 键为函数起始加载地址，模块卸载、进程退出或目标销毁时整体清空。
+ *
+ * 所有方法线程安全。
+ */
+class LexicalScopeCache {
+    struct FunctionScopes;
+
+public:
+    /**
+     * @brief 某个 PC 处的变量可见性，由 Resolve 生成，只在单个请求内使用
+     */
+    class Visibility {
+    public:
+        /**
+         * @brief 判断变量是否可见
+         *
+         * 变量按名称与声明行匹配到函数内的词法块时，返回该块是否覆盖 PC；
+         * 未匹配到（参数、静态变量、无调试信息的函数等）时视为可见。
+         */
+        [[nodiscard]] bool IsVisible(const char* name, uint32_t decl_line) const;
+
+    private:
+        friend class LexicalScopeCache;
+
+        std::shared_ptr<const FunctionScopes> scopes_;
+        std::vector<bool> active_blocks_;
+    };
+
+    LexicalScopeCache() = default;
+
+    LexicalScopeCache(const LexicalScopeCache&) = delete;
+    LexicalScopeCache& operator=(const LexicalScopeCache&) = delete;
+
+    /**
+     * @brief 计算函数内各词法块在给定 PC 处是否有效
+     * @param function 帧所在函数，无效时返回的结果将所有变量视为可见
+     * @param pc 查询地址；非最内层帧应传入返回地址减一，使其落在调用指令所在的块内
+     */
+    Visibility Resolve(lldb::SBFunction function, lldb::addr_t pc, lldb::SBTarget& target);
+
+    /**
+     * @brief 清空全部条目（模块卸载、进程退出、目标销毁时调用）
+     */
+    void Clear();
+
+    /**
+     * @brief 已缓存的函数数量
+     */
+    [[nodiscard]] size_t Size() const;
+
+private:
+    struct Declaration {
+        std::string name;
+        uint32_t block = 0;
+    };
+
+    struct FunctionScopes {
+        // 按块下标存放的地址范围 [start, end)
+        std::vector<std::vector<std::pair<lldb::addr_t, lldb::addr_t>>> block_ranges;
+        // 声明行 -> 该行声明的局部变量
+        std::unordered_map<uint32_t, std::vector<Declaration>> declarations;
+    };
+
+    static std::shared_ptr<const FunctionScopes> Build(lldb::SBFunction& function, lldb::SBTarget& target);
+
+    mutable std::mutex mutex_;
+    std::unordered_map<lldb::addr_t, std::shared_ptr<const FunctionScopes>> functions_;
+};
+
+} // namespace Debugger
+} // namespace Cangjie
+
+#endif // CANGJIE_DEBUGGER_LEXICAL_SCOPE_CACHE_H
@@ -0,0 +1,100 @@
+/*
+ * Copyright 2025 LinQingYing. and contributors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * The use of this source code is governed by the Apache License 2.0,
+ * which allows users to freely use, modify, and distribute the code,
+ * provided they adhere to the terms of the license.
+ *
+ * The software is provided "as-is", and the authors are not responsible for
+ * any damages or issues arising from its use.
+ *
+ */
+
+
+#ifndef CANGJIE_DEBUGGER_PRIMITIVE_ARRAY_DECODER_H
+#define CANGJIE_DEBUGGER_PRIMITIVE_ARRAY_DECODER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <lldb/API/LLDB.h>
+
+namespace Cangjie {
+namespace Debugger {
+
+/**
+ * @brief 基本类型元素的编码方式
+ */
+enum class PrimitiveEncoding : uint8_t {
+    BOOL,
+    SIGNED,
+    UNSIGNED,
+    FLOAT
+};
+
+/**
+ * @brief 连续存储的基本类型数组元素布局
+ */
+struct PrimitiveLayout {
+    PrimitiveEncoding encoding = PrimitiveEncoding::SIGNED;
+    uint32_t byte_size = 0;     // 1、2、4、8（浮点仅支持 4、8）
+};
+
+/**
+ * @brief 将一次内存读取得到的连续数组数据解码为各元素的显示值
+ *
+ * 先按元素宽度整体拷贝、按需字节交换并扩展到 64 位（无分支的定长循环，便于编译器向量化），
+ * 再统一格式化为字符串，避免逐元素调用 LLDB。
+ */
+class PrimitiveArrayDecoder {
+public:
+    /**
+     * @brief 判断布局是否受支持
+     */
+    static bool IsSupported(const PrimitiveLayout& layout);
+
+    /**
+     * @brief 判断元素类型能否在本地解码
+     *
+     * 字符类型（LLDB 按字符字面量显示）、枚举和非标量类型不在此列。
+     * @return 可解码时返回元素布局
+     */
+    static std::optional<PrimitiveLayout> ClassifyType(lldb::SBType type);
+
+    /**
+     * @brief 主机字节序，与目标字节序不同时解码需要字节交换
+     */
+    static lldb::ByteOrder HostByteOrder();
+
+    /**
+     * @brief 解码元素
+     * @param layout 元素布局
+     * @param swap_bytes 目标字节序与主机不同时为 true
+     * @param data 原始内存，长度至少为 count * layout.byte_size
+     * @param count 元素数量
+     * @param values 输出：每个元素的显示值，与 SBValue::GetValue() 的默认格式一致
+     * @return 布局不受支持，或标准库缺少浮点 std::to_chars 而无法输出最短往返形式时返回 false
+     */
+    static bool Decode(const PrimitiveLayout& layout, bool swap_bytes, const uint8_t* data, size_t count,
+                       std::vector<std::string>* values);
+};
+
+} // namespace Debugger
+} // namespace Cangjie
+
+#endif // CANGJIE_DEBUGGER_PRIMITIVE_ARRAY_DECODER_H
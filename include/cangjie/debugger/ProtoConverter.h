@@ -43,6 +43,8 @@
 #include "lldb/API/SBBreakpoint.h"
 #include "lldb/API/SBWatchpoint.h"
 
+#include "cangjie/debugger/TypeCache.h"
+
 
 
 
@@ -95,6 +97,18 @@ namespace Cangjie {
                 lldbprotobuf::HashAlgorithm hash_algorithm = lldbprotobuf::HASH_ALGORITHM_NONE,
                 const std::string &hash_value = "");
 
+            /**
+             * @brief 在已有消息上填充源代码位置信息
+             *
+             * Fill* 系列方法直接写入目标消息（可以是 arena 上的子消息），避免构造临时对象再复制。
+             */
+            static void FillSourceLocation(
+                lldbprotobuf::SourceLocation *location,
+                const std::string &file_path,
+                uint32_t line,
+                lldbprotobuf::HashAlgorithm hash_algorithm = lldbprotobuf::HASH_ALGORITHM_NONE,
+                const std::string &hash_value = "");
+
             // ========================================================================
             // 线程和执行状态转换
             // ========================================================================
@@ -109,6 +123,11 @@ namespace Cangjie {
              */
             static lldbprotobuf::ThreadStopInfo CreateThreadStopInfo(lldb::SBThread &sb_thread);
 
+            /**
+             * @brief 在已有消息上填充线程停止信息
+             */
+            static void FillThreadStopInfo(lldbprotobuf::ThreadStopInfo *stop_info, lldb::SBThread &sb_thread);
+
             /**
              * @brief 获取信号名称
              */
@@ -125,16 +144,33 @@ namespace Cangjie {
              */
             static lldbprotobuf::Thread CreateThread(lldb::SBThread &sb_thread);
 
+            /**
+             * @brief 在已有消息上填充线程信息
+             */
+            static void FillThread(lldbprotobuf::Thread *thread, lldb::SBThread &sb_thread);
+
             /**
              * @brief 创建栈帧信息
              */
             static lldbprotobuf::Frame CreateFrame(lldb::SBFrame &sb_frame);
 
+            /**
+             * @brief 在已有消息上填充栈帧信息
+             */
+            static void FillFrame(lldbprotobuf::Frame *frame, lldb::SBFrame &sb_frame);
+
             static lldbprotobuf::Type CreateType(lldb::SBType &sb_type);
 
             static lldbprotobuf::Type CreateType(std::string type_name, std::optional<lldbprotobuf::TypeKind> type_kind,
                                                  std::string display_type);
 
+            static void FillType(lldbprotobuf::Type *type, lldb::SBType &sb_type);
+
+            static void FillType(lldbprotobuf::Type *type,
+                                 const std::string &type_name,
+                                 std::optional<lldbprotobuf::TypeKind> type_kind,
+                                 const std::string &display_type);
+
 
             /**
              * @brief 将 LLDB TypeClass 转换为 protobuf TypeKind
@@ -148,8 +184,22 @@ namespace Cangjie {
 
             /**
              * @brief 创建变量信息
+             * @param type_cache 类型描述缓存，为空时每次都重新转换类型
              */
-            static lldbprotobuf::Variable CreateVariable(lldb::SBValue &sb_value, uint64_t variable_id);
+            static lldbprotobuf::Variable CreateVariable(lldb::SBValue &sb_value, uint64_t variable_id,
+                                                         TypeCache *type_cache = nullptr);
+
+            /**
+             * @brief 在已有消息上填充变量信息
+             * @param type_cache 类型描述缓存，为空时每次都重新转换类型
+             */
+            static void FillVariable(lldbprotobuf::Variable *variable, lldb::SBValue &sb_value, uint64_t variable_id,
+                                     TypeCache *type_cache = nullptr);
+
+            /**
+             * @brief 填充变量的类型描述，优先从缓存获取
+             */
+            static void FillVariableType(lldbprotobuf::Type *type, lldb::SBValue &sb_value, TypeCache *type_cache);
 
             /**
              * @brief 创建变量值信息
@@ -158,10 +208,12 @@ namespace Cangjie {
 
             /**
              * @brief 创建变量值信息（带限制参数）
+             * @param include_summary 为 false 时不调用摘要提供器，摘要以占位符返回并标记为延迟
              */
             static lldbprotobuf::Value CreateValue(lldb::SBValue &sb_value,
                                                    uint64_t variable_id,
-                                                   uint32_t max_string_length = 1000);
+                                                   uint32_t max_string_length = 1000,
+                                                   bool include_summary = true);
 
 
             // ========================================================================
@@ -196,6 +248,14 @@ namespace Cangjie {
                 bool success,
                 const std::string &error_message = "");
 
+            /**
+             * @brief 在已有消息上填充响应状态
+             */
+            static void FillResponseStatus(
+                lldbprotobuf::Status *status,
+                bool success,
+                const std::string &error_message = "");
+
             static lldbprotobuf::CreateTargetResponse CreateCreateTargetResponse(
                 bool success,
                 const std::string &error_message);
@@ -268,6 +328,22 @@ namespace Cangjie {
                 bool success,
                 const std::string &error_message = "");
 
+            /**
+             * @brief 创建配置停止快照响应
+             */
+            static lldbprotobuf::ConfigureStopSnapshotResponse CreateConfigureStopSnapshotResponse(
+                bool success,
+                uint32_t max_frames,
+                uint32_t max_locals,
+                const std::string &error_message = "");
+
+            /**
+             * @brief 创建配置字符串驻留响应
+             */
+            static lldbprotobuf::ConfigureStringInternResponse CreateConfigureStringInternResponse(
+                bool success,
+                const std::string &error_message = "");
+
 
             // ========================================================================
             // 事件消息创建
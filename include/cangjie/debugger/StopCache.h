@@ -0,0 +1,129 @@
+/*
+ * Copyright 2025 LinQingYing. and contributors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * The use of this source code is governed by the Apache License 2.0,
+ * which allows users to freely use, modify, and distribute the code,
+ * provided they adhere to the terms of the license.
+ *
+ * The software is provided "as-is", and the authors are not responsible for
+ * any damages or issues arising from its use.
+ *
+ */
+
+
+
+#ifndef CANGJIE_DEBUGGER_STOP_CACHE_H
+#define CANGJIE_DEBUGGER_STOP_CACHE_H
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include <google/protobuf/message.h>
+
+namespace Cangjie {
+namespace Debugger {
+
+/**
+ * @brief 以 SBProcess::GetStopID() 为作用域的响应缓存
+ *
+ * 进程保持停止期间，相同的查询请求（线程列表、栈帧、变量、寄存器）结果不变，
+ * 缓存已转换好的响应消息，重复请求直接拷贝返回而无需再次访问 LLDB。
+ * 停止 ID 变化（进程恢复运行后再次停止）时整体失效。
+ *
+ * 所有方法线程安全。
+ */
+class StopCache {
+public:
+    /**
+     * @brief 缓存条目类别
+     *
+     * 值类条目（变量、寄存器、表达式求值结果）在调试器修改被调试程序状态后需要单独失效，
+     * 结构类条目（线程、栈帧）只随停止 ID 失效。
+     */
+    enum class Kind : uint8_t {
+        THREADS,
+        FRAMES,
+        VARIABLES,
+        REGISTERS,
+        EVALUATIONS
+    };
+
+    StopCache() = default;
+
+    StopCache(const StopCache&) = delete;
+    StopCache& operator=(const StopCache&) = delete;
+
+    /**
+     * @brief 查找缓存条目
+     * @param stop_id 当前停止 ID，与缓存的停止 ID 不同时清空缓存
+     * @param kind 条目类别
+     * @param key 条目键（通常为序列化后的请求）
+     * @param out 命中时拷贝到该消息，类型必须与存入时一致
+     * @return 命中返回 true
+     */
+    bool Lookup(uint32_t stop_id, Kind kind, const std::string& key, google::protobuf::Message* out);
+
+    /**
+     * @brief 存入缓存条目
+     * @param stop_id 产生该结果时的停止 ID
+     * @param kind 条目类别
+     * @param key 条目键
+     * @param value 要缓存的消息（拷贝保存）
+     */
+    void Store(uint32_t stop_id, Kind kind, const std::string& key, const google::protobuf::Message& value);
+
+    /**
+     * @brief 使全部条目失效（进程恢复运行时调用）
+     */
+    void Invalidate();
+
+    /**
+     * @brief 仅使值类条目失效（修改变量、内存或执行可能有副作用的表达式后调用）
+     */
+    void InvalidateValues();
+
+    /**
+     * @brief 缓存命中次数
+     */
+    [[nodiscard]] uint64_t GetHitCount() const;
+
+    /**
+     * @brief 缓存未命中次数
+     */
+    [[nodiscard]] uint64_t GetMissCount() const;
+
+private:
+    using EntryMap = std::unordered_map<std::string, std::unique_ptr<google::protobuf::Message>>;
+
+    static constexpr size_t KIND_COUNT = 5;
+
+    // 调用方需持有 mutex_
+    void ResetIfStale(uint32_t stop_id);
+
+    mutable std::mutex mutex_;
+    bool valid_ = false;
+    uint32_t stop_id_ = 0;
+    EntryMap entries_[KIND_COUNT];
+    uint64_t hits_ = 0;
+    uint64_t misses_ = 0;
+};
+
+} // namespace Debugger
+} // namespace Cangjie
+
+#endif // CANGJIE_DEBUGGER_STOP_CACHE_H
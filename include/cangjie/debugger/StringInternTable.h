@@ -0,0 +1,83 @@
+/*
+ * Copyright 2025 LinQingYing. and contributors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * The use of this source code is governed by the Apache License 2.0,
+ * which allows users to freely use, modify, and distribute the code,
+ * provided they adhere to the terms of the license.
+ *
+ * The software is provided "as-is", and the authors are not responsible for
+ * any damages or issues arising from its use.
+ *
+ */
+
+
+#ifndef CANGJIE_DEBUGGER_STRING_INTERN_TABLE_H
+#define CANGJIE_DEBUGGER_STRING_INTERN_TABLE_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+namespace Cangjie {
+namespace Debugger {
+
+/**
+ * @brief 会话级字符串驻留表
+ *
+ * 为响应中反复出现的长字符串分配从 1 开始的 Id。调用方在字符串首次驻留时
+ * 将定义随响应发出，之后只发送 Id。过短的字符串（引用不比原文省）和表满之后
+ * 遇到的新字符串不驻留，照常内联发送。
+ *
+ * 只在请求线程中使用，不加锁。
+ */
+class StringInternTable {
+public:
+    // 参与驻留的最短字符串长度
+    static constexpr size_t MIN_INTERN_LENGTH = 8;
+
+    // 驻留表最大条目数，防止会话期间无限增长
+    static constexpr size_t MAX_ENTRIES = 1u << 16;
+
+    StringInternTable() = default;
+
+    StringInternTable(const StringInternTable&) = delete;
+    StringInternTable& operator=(const StringInternTable&) = delete;
+
+    /**
+     * @brief 驻留字符串
+     * @param value 字符串内容
+     * @param is_new 输出：本次调用是否新分配了 Id（调用方需发送定义）
+     * @return 驻留 Id；不驻留时返回 0
+     */
+    uint32_t Intern(const std::string& value, bool* is_new);
+
+    /**
+     * @brief 清空驻留表，Id 重新从 1 开始分配
+     */
+    void Reset();
+
+    /**
+     * @brief 当前驻留的字符串数量
+     */
+    [[nodiscard]] size_t Size() const { return ids_.size(); }
+
+private:
+    std::unordered_map<std::string, uint32_t> ids_;
+};
+
+} // namespace Debugger
+} // namespace Cangjie
+
+#endif // CANGJIE_DEBUGGER_STRING_INTERN_TABLE_H
@@ -26,7 +26,13 @@
 #define CANGJIE_DEBUGGER_TCP_CLIENT_H
 
 
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 
 #ifdef _WIN32
 #include <winsock2.h>
@@ -37,13 +43,27 @@ typedef int SOCKET_TYPE;
 
 namespace lldbprotobuf {
     class Request;
-    class Event;
     class Response;
 }
 
 namespace Cangjie {
 namespace Debugger {
 
+/**
+ * @brief 发送队列统计信息快照
+ *
+ * 用于判断瓶颈是否在 IDE 端：队列持续堆积且发送延迟升高时，说明对端读取过慢。
+ */
+struct TcpSendStats {
+    uint64_t frames_sent = 0;       ///< 已写入 socket 的帧数
+    uint64_t bytes_sent = 0;        ///< 已写入 socket 的字节数（含 4 字节长度头）
+    uint64_t batches_sent = 0;      ///< 批量写调用次数
+    uint64_t queue_depth = 0;       ///< 当前待发送的帧数
+    uint64_t max_queue_depth = 0;   ///< 历史最大待发送帧数
+    uint64_t total_latency_us = 0;  ///< 入队到写完的累计延迟（微秒）
+    uint64_t max_latency_us = 0;    ///< 入队到写完的最大延迟（微秒）
+};
+
 class TcpClient {
 public:
     TcpClient();
@@ -53,23 +73,147 @@ public:
     void Disconnect();
     [[nodiscard]] bool IsConnected() const;
 
+    /**
+     * @brief 获取底层 socket 句柄，用于注册到事件循环
+     */
+    [[nodiscard]] SOCKET_TYPE GetSocket() const;
+
     [[nodiscard]] bool SendProtoMessage(const lldbprotobuf::Response &response) const;
-    [[nodiscard]] bool SendEventBroadcast(const lldbprotobuf::Event& event) const;
+    /**
+     * @brief 发送事件广播
+     * @param event_response 已设置 event 字段的 Response 信封，由调用方直接构造以避免复制事件
+     */
+    [[nodiscard]] bool SendEventBroadcast(const lldbprotobuf::Response& event_response) const;
     bool ReceiveData(char* buffer, size_t buffer_size, size_t& bytes_received);
     [[nodiscard]] bool ReceiveProtoMessage(lldbprotobuf::Request& request) const;
 
-
+    /**
+     * @brief 是否还有已解码但尚未取出的请求
+     *
+     * 一次 recv 可能读到多个完整帧，事件循环在 socket 可读时应持续取出直到返回 false。
+     */
+    [[nodiscard]] bool HasBufferedRequests() const;
+
+    /**
+     * @brief 非阻塞地执行一次 recv，并解码其中所有完整帧
+     *
+     * 供事件循环在 socket 可读时调用：帧不完整时立即返回，剩余数据在下次可读通知时继续读取，
+     * 不会阻塞事件循环。解码出的请求通过 HasBufferedRequests()/ReceiveProtoMessage() 取出。
+     * @return 连接关闭、出错或遇到非法帧时返回 false
+     */
+    [[nodiscard]] bool ReceiveAvailable() const;
+
+    /**
+     * @brief 等待 socket 可读或已缓存完整请求
+     * @param timeout_ms 最长等待时间（毫秒）
+     * @return 可读返回 1，超时返回 0，出错返回 -1
+     */
+    [[nodiscard]] int WaitReadable(int timeout_ms) const;
+
+    /**
+     * @brief 获取发送队列的统计信息
+     * @return 队列深度与发送延迟计数器的快照
+     */
+    [[nodiscard]] TcpSendStats GetSendStats() const;
 
 private:
+    /**
+     * @brief 已序列化的待发送帧（[4字节大小][消息内容]），作为无锁队列的侵入式节点
+     */
+    struct OutboundFrame;
+
+    /**
+     * @brief 将消息直接序列化到帧缓冲区（长度头之后）并放入发送队列，由写线程异步发送
+     * @param response 要发送的消息
+     * @param kind 日志中使用的消息类别
+     * @return 入队成功返回 true
+     */
+    bool EnqueueMessage(const lldbprotobuf::Response& response, const char* kind) const;
+
+    /**
+     * @brief 从缓冲池取出一个帧并调整到指定大小
+     */
+    OutboundFrame* AcquireFrame(size_t frame_size) const;
+
+    /**
+     * @brief 写出完成后将帧归还缓冲池
+     */
+    void ReleaseFrame(OutboundFrame* frame) const;
+
+    /**
+     * @brief 多生产者单消费者无锁入队（Vyukov 算法）
+     */
+    void PushFrame(OutboundFrame* frame) const;
+
+    /**
+     * @brief 单消费者出队，仅由写线程调用
+     * @return 队首帧，队列为空或生产者尚未完成链接时返回 nullptr
+     */
+    OutboundFrame* PopFrame() const;
+
+    void StartWriterThread();
+    void StopWriterThread();
+    void WriterThreadLoop();
+
+    /**
+     * @brief 使用 writev（Windows 下为 WSASend）一次写出一批帧
+     */
+    bool WriteBatch(const std::vector<OutboundFrame*>& batch) const;
+
+    /**
+     * @brief 执行一次 recv，读取当前可用的全部数据到接收缓冲区
+     * @param nonblocking 为 true 时暂无数据立即返回，不等待
+     * @return 连接关闭或出错时返回 false
+     */
+    bool FillReceiveBuffer(bool nonblocking = false) const;
+
+    /**
+     * @brief 从接收缓冲区中就地解析所有完整帧，放入待处理请求队列
+     * @return 遇到非法帧时返回 false
+     */
+    bool DecodeBufferedFrames() const;
+
     SOCKET_TYPE socket_;
-    bool connected_;
+    std::atomic<bool> connected_;
+
+    // 接收缓冲区：复用同一块内存，[recv_begin_, recv_end_) 为尚未解析的数据
+    mutable std::vector<char> recv_buffer_;
+    mutable size_t recv_begin_;
+    mutable size_t recv_end_;
+
+    // 已解码的请求队列，请求对象在队列清空后复用，避免每条消息重新分配
+    mutable std::vector<lldbprotobuf::Request> pending_requests_;
+    mutable size_t pending_head_;
+    mutable size_t pending_count_;
 
 #ifdef _WIN32
     bool wsa_initialized_;
 #endif
 
-
-
+    // 发送队列：生产者（请求线程、事件线程）只负责序列化和入队，不会阻塞在 socket 上
+    mutable std::atomic<OutboundFrame*> queue_head_;
+    mutable OutboundFrame* queue_tail_;
+    OutboundFrame* queue_stub_;
+
+    // 写线程
+    std::thread writer_thread_;
+    std::atomic<bool> writer_running_;
+    mutable std::atomic<bool> write_failed_;
+    mutable std::mutex writer_mutex_;
+    mutable std::condition_variable writer_cv_;
+
+    // 已写出帧的缓冲池，复用帧缓冲区
+    mutable std::mutex frame_pool_mutex_;
+    mutable std::vector<OutboundFrame*> frame_pool_;
+
+    // 统计计数器
+    mutable std::atomic<uint64_t> queue_depth_;
+    mutable std::atomic<uint64_t> max_queue_depth_;
+    mutable std::atomic<uint64_t> frames_sent_;
+    mutable std::atomic<uint64_t> bytes_sent_;
+    mutable std::atomic<uint64_t> batches_sent_;
+    mutable std::atomic<uint64_t> total_latency_us_;
+    mutable std::atomic<uint64_t> max_latency_us_;
 };
 
 } // namespace Debugger
@@ -0,0 +1,105 @@
+/*
+ * Copyright 2025 LinQingYing. and contributors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * The use of this source code is governed by the Apache License 2.0,
+ * which allows users to freely use, modify, and distribute the code,
+ * provided they adhere to the terms of the license.
+ *
+ * The software is provided "as-is", and the authors are not responsible for
+ * any damages or issues arising from its use.
+ *
+ */
+
+
+#ifndef CANGJIE_DEBUGGER_TYPE_CACHE_H
+#define CANGJIE_DEBUGGER_TYPE_CACHE_H
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "model.pb.h"
+
+namespace Cangjie {
+namespace Debugger {
+
+/**
+ * @brief 已转换类型描述的缓存
+ *
+ * 同一模块中的同名类型转换结果固定，变量及其子变量重复出现同一类型时
+ * 直接复用缓存的 lldbprotobuf::Type，避免每个变量都重新查询 LLDB 类型系统。
+ * 键为模块 UUID 与类型名的组合，模块卸载或目标销毁时整体清空。
+ *
+ * 所有方法线程安全。
+ */
+class TypeCache {
+public:
+    TypeCache() = default;
+
+    TypeCache(const TypeCache&) = delete;
+    TypeCache& operator=(const TypeCache&) = delete;
+
+    /**
+     * @brief 生成缓存键
+     * @param module_uuid 类型所属模块的 UUID，可为空
+     * @param type_name 类型名
+     */
+    static std::string MakeKey(const char* module_uuid, const char* type_name);
+
+    /**
+     * @brief 查找缓存的类型描述
+     * @param key MakeKey 生成的键
+     * @param out 命中时拷贝到该消息
+     * @return 命中返回 true
+     */
+    bool Lookup(const std::string& key, lldbprotobuf::Type* out);
+
+    /**
+     * @brief 存入类型描述（拷贝保存）
+     */
+    void Store(const std::string& key, const lldbprotobuf::Type& type);
+
+    /**
+     * @brief 清空全部条目（模块卸载、目标销毁时调用），命中统计保留
+     */
+    void Clear();
+
+    /**
+     * @brief 缓存命中次数
+     */
+    [[nodiscard]] uint64_t GetHitCount() const;
+
+    /**
+     * @brief 缓存未命中次数
+     */
+    [[nodiscard]] uint64_t GetMissCount() const;
+
+    /**
+     * @brief 命中率（0.0 ~ 1.0），尚无查询时返回 0
+     */
+    [[nodiscard]] double GetHitRate() const;
+
+private:
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, lldbprotobuf::Type> entries_;
+    uint64_t hits_ = 0;
+    uint64_t misses_ = 0;
+};
+
+} // namespace Debugger
+} // namespace Cangjie
+
+#endif // CANGJIE_DEBUGGER_TYPE_CACHE_H
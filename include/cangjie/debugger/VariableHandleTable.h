@@ -0,0 +1,201 @@
+/*
+ * Copyright 2025 LinQingYing. and contributors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * The use of this source code is governed by the Apache License 2.0,
+ * which allows users to freely use, modify, and distribute the code,
+ * provided they adhere to the terms of the license.
+ *
+ * The software is provided "as-is", and the authors are not responsible for
+ * any damages or issues arising from its use.
+ *
+ */
+
+
+
+#ifndef CANGJIE_DEBUGGER_VARIABLE_HANDLE_TABLE_H
+#define CANGJIE_DEBUGGER_VARIABLE_HANDLE_TABLE_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <lldb/API/LLDB.h>
+
+namespace Cangjie {
+namespace Debugger {
+
+/**
+ * @brief 变量来源：重新定位同一逻辑变量所需的信息
+ */
+struct VariableOrigin {
+    uint64_t thread_id = 0;
+    uint32_t frame_index = 0;
+    uint64_t frame_cfa = 0;      // 帧 CFA，不可用时为 0
+    std::string path;            // 变量表达式路径
+};
+
+/**
+ * @brief 变量值相对于之前停止的变化情况
+ */
+enum class ValueChange : uint8_t {
+    UNKNOWN,    // 之前的停止中没有记录过该变量的值
+    UNCHANGED,
+    CHANGED
+};
+
+/**
+ * @brief 变量句柄表：带代数计数的槽位数组（slab）
+ *
+ * 句柄编码为 (generation << 32) | (slot + 1)，查找只需一次下标访问和两次比较：
+ *   - 槽位被回收（Clear()）后 generation 递增，旧句柄自然失效；
+ *   - 进程恢复运行时递增停止代（epoch），所有句柄的 SBValue 一次性失效，复杂度 O(1)。
+ *
+ * 同一逻辑变量（相同的来源键）在多次停止之间复用同一槽位，因此句柄保持稳定。
+ * 槽位只在 Clear() 时回收，不按访问时间老化，因此客户端持有的句柄在整个会话内都可按来源重建。
+ *
+ * 持有 SBValue 的槽位按最近使用顺序串成 LRU 链表，数量超过预算时淘汰最久未用的 SBValue，
+ * 但保留槽位和来源信息，句柄仍然有效，调用方可按来源重建后通过 Refresh() 写回。
+ *
+ * 每个槽位还保存最近发送的值指纹，用于跨停止判断值是否变化（SBValue 实例每次停止都会重建，
+ * 无法依赖 SBValue::GetValueDidChange()）。
+ *
+ * 非线程安全，只在请求处理线程中使用。
+ */
+class VariableHandleTable {
+public:
+    VariableHandleTable() = default;
+
+    VariableHandleTable(const VariableHandleTable&) = delete;
+    VariableHandleTable& operator=(const VariableHandleTable&) = delete;
+
+    /**
+     * @brief 为变量获取句柄
+     * @param key 来源键（线程、帧、路径的哈希），相同键复用同一槽位
+     * @param origin 变量来源
+     * @param value 当前停止代中的 SBValue；传入无效值时只登记来源，首次访问时由调用方重建
+     * @return 句柄，永不为 0
+     */
+    uint64_t Acquire(uint64_t key, VariableOrigin origin, const lldb::SBValue& value);
+
+    /**
+     * @brief 查找句柄对应的 SBValue，命中时标记为最近使用
+     * @return 句柄无效、已回收、已被淘汰或属于之前的停止代时返回无效的 SBValue
+     */
+    lldb::SBValue Find(uint64_t handle);
+
+    /**
+     * @brief 为仍然有效的句柄写回重建的 SBValue
+     * @return 句柄已回收或无效时返回 false
+     */
+    bool Refresh(uint64_t handle, const lldb::SBValue& value);
+
+    /**
+     * @brief 获取句柄对应的变量来源（即使 SBValue 已失效，只要槽位未被回收）
+     * @return 槽位已回收或句柄无效时返回 nullptr
+     */
+    const VariableOrigin* FindOrigin(uint64_t handle) const;
+
+    /**
+     * @brief 记录句柄在当前停止代中的值指纹，并与之前停止代最后记录的指纹比较
+     * @param fingerprint 值与摘要的哈希
+     * @return 句柄无效或之前的停止中从未记录时返回 UNKNOWN
+     */
+    ValueChange RecordFingerprint(uint64_t handle, uint64_t fingerprint);
+
+    /**
+     * @brief 进入新的停止代，使所有句柄的 SBValue 失效
+     */
+    void BumpEpoch();
+
+    /**
+     * @brief 回收所有槽位
+     * @return 回收的槽位数量
+     */
+    size_t Clear();
+
+    /**
+     * @brief 正在使用的槽位数量
+     */
+    [[nodiscard]] size_t Size() const;
+
+    /**
+     * @brief 设置同时持有 SBValue 的最大句柄数量（0 表示不限制）
+     */
+    void SetMaxLiveValues(size_t max_live_values);
+
+    /**
+     * @brief 当前持有 SBValue 的句柄数量
+     */
+    [[nodiscard]] size_t LiveCount() const;
+
+    /**
+     * @brief 因超出预算被淘汰的 SBValue 累计数量
+     */
+    [[nodiscard]] uint64_t EvictionCount() const;
+
+private:
+    static constexpr uint32_t INVALID_SLOT = UINT32_MAX;
+
+    struct Slot {
+        lldb::SBValue value;
+        VariableOrigin origin;
+        uint64_t key = 0;
+        uint32_t generation = 1;
+        uint32_t epoch = 0;         // 写入 value 时的停止代
+        uint32_t next_free = INVALID_SLOT;
+        uint32_t lru_prev = INVALID_SLOT;
+        uint32_t lru_next = INVALID_SLOT;
+        bool in_use = false;
+        bool live = false;          // 是否持有 SBValue（位于 LRU 链表中）
+        uint64_t fingerprint = 0;           // 最近一次记录的值指纹
+        uint64_t previous_fingerprint = 0;  // 之前停止代最后记录的值指纹
+        uint32_t fingerprint_epoch = 0;     // fingerprint 所属的停止代
+        bool has_fingerprint = false;
+        bool has_previous_fingerprint = false;
+    };
+
+    static uint64_t MakeHandle(uint32_t slot, uint32_t generation);
+
+    // 返回句柄对应的在用槽位，否则返回 nullptr
+    const Slot* Resolve(uint64_t handle) const;
+
+    void Release(uint32_t slot_index);
+
+    // 写入 SBValue 并移到 LRU 链表头部
+    void StoreValue(uint32_t slot_index, const lldb::SBValue& value);
+
+    void LinkFront(uint32_t slot_index);
+    void Unlink(uint32_t slot_index);
+
+    // 淘汰 LRU 尾部的 SBValue 直到不超过预算
+    void EnforceBudget();
+
+    std::vector<Slot> slots_;
+    std::unordered_map<uint64_t, uint32_t> key_index_;
+    uint32_t free_head_ = INVALID_SLOT;
+    uint32_t epoch_ = 0;
+    size_t in_use_ = 0;
+    uint32_t lru_head_ = INVALID_SLOT;
+    uint32_t lru_tail_ = INVALID_SLOT;
+    size_t live_count_ = 0;
+    size_t max_live_values_ = 0;
+    uint64_t evictions_ = 0;
+};
+
+} // namespace Debugger
+} // namespace Cangjie
+
+#endif // CANGJIE_DEBUGGER_VARIABLE_HANDLE_TABLE_H
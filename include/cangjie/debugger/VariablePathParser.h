@@ -0,0 +1,61 @@
+/*
+ * Copyright 2025 LinQingYing. and contributors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * The use of this source code is governed by the Apache License 2.0,
+ * which allows users to freely use, modify, and distribute the code,
+ * provided they adhere to the terms of the license.
+ *
+ * The software is provided "as-is", and the authors are not responsible for
+ * any damages or issues arising from its use.
+ *
+ */
+
+#ifndef CANGJIE_DEBUGGER_VARIABLE_PATH_PARSER_H
+#define CANGJIE_DEBUGGER_VARIABLE_PATH_PARSER_H
+
+#include <optional>
+#include <string>
+
+namespace Cangjie {
+namespace Debugger {
+
+/**
+ * @brief 解析后的变量路径
+ */
+struct VariablePath {
+    std::string root;           // 根变量名
+    std::string path;           // 去除空白后的完整路径，可直接传给 SBFrame::GetValueForVariablePath
+    bool is_identifier = false; // 路径只有根变量名，可直接用 SBFrame::FindVariable 查找
+};
+
+/**
+ * @brief 识别可以不经表达式引擎求值的简单变量路径
+ *
+ * 接受的形式：可选的前导解引用 '*'，变量名，后接任意个 ".成员"、"->成员"、"[十进制下标]"，
+ * 记号之间允许空白。例如 "obj.field[3]"、"*node->next"。
+ * 函数调用、运算符、字面量、类型转换等均不接受，由调用方交给表达式引擎。
+ */
+class VariablePathParser {
+public:
+    /**
+     * @return 表达式是简单变量路径时返回解析结果，否则返回 std::nullopt
+     */
+    static std::optional<VariablePath> Parse(const std::string& expression);
+};
+
+} // namespace Debugger
+} // namespace Cangjie
+
+#endif // CANGJIE_DEBUGGER_VARIABLE_PATH_PARSER_H
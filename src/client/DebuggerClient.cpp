@@ -44,8 +44,17 @@
 
 
 namespace Cangjie::Debugger {
+    namespace {
+        // 默认同时持有 SBValue 的最大变量数量，超出后淘汰最久未用的变量
+        constexpr size_t DEFAULT_MAX_LIVE_VARIABLES = 50000;
+
+        // 无事件循环时，请求线程等待请求的最长时间，到期后处理排队的 LLDB 事件
+        constexpr int QUEUED_EVENT_POLL_INTERVAL_MS = 20;
+    }
+
     DebuggerClient::DebuggerClient(TcpClient &tcp_client)
         : tcp_client_(tcp_client)
+          , reactor_()
           , breakpoint_manager_(std::make_unique<cangjie::debugger::BreakpointManager>())
           , debugger_()
           , target_()
@@ -54,7 +63,15 @@ namespace Cangjie::Debugger {
           , event_thread_()
           , event_thread_running_(false)
           , event_listener_()
-          , variable_id_map_() {
+          , wakeup_broadcaster_("cangjie.debugger.wakeup")
+          , variable_handles_() {
+        variable_handles_.SetMaxLiveValues(DEFAULT_MAX_LIVE_VARIABLES);
+
+        // 先初始化事件循环，使事件线程从一开始就能把事件投递到循环线程
+        if (!reactor_.Initialize()) {
+            LOG_INFO("Event reactor unavailable, falling back to blocking message loop");
+        }
+
         // 在构造时初始化 LLDB
         InitializeLLDB();
     }
@@ -172,6 +189,9 @@ namespace Cangjie::Debugger {
         if (request.has_get_value()) {
             return HandleGetValueRequest(request.get_value(), request.hash());
         }
+        if (request.has_get_summaries()) {
+            return HandleGetSummariesRequest(request.get_summaries(), request.hash());
+        }
 
         if (request.has_set_variable_value()) {
             return HandleSetVariableValueRequest(request.set_variable_value(), request.hash());
@@ -185,6 +205,12 @@ namespace Cangjie::Debugger {
         if (request.has_evaluate()) {
             return HandleEvaluateRequest(request.evaluate(), request.hash());
         }
+        if (request.has_evaluate_expressions()) {
+            return HandleEvaluateExpressionsRequest(request.evaluate_expressions(), request.hash());
+        }
+        if (request.has_subscribe_watches()) {
+            return HandleSubscribeWatchesRequest(request.subscribe_watches(), request.hash());
+        }
 
         // Memory and Disassembly
         if (request.has_read_memory()) {
@@ -203,44 +229,163 @@ namespace Cangjie::Debugger {
             return HandleGetFunctionInfoRequest(request.get_function_info(), request.hash());
         }
 
+        // Session Configuration
+        if (request.has_configure_stop_snapshot()) {
+            return HandleConfigureStopSnapshotRequest(request.configure_stop_snapshot(), request.hash());
+        }
+        if (request.has_configure_string_intern()) {
+            return HandleConfigureStringInternRequest(request.configure_string_intern(), request.hash());
+        }
+
+        // Batch
+        if (request.has_batch()) {
+            return HandleBatchRequest(request.batch(), request.hash());
+        }
+
 
         LOG_WARNING("Received unknown or unhandled request type");
         return false;
     }
 
+    bool DebuggerClient::DispatchRequest(
+        const lldbprotobuf::Request &request,
+        const std::function<bool(const lldbprotobuf::Request &)> &request_handler
+    ) {
+        // 检查是否为空消息（size 0），如果是则跳过处理
+        if (!request.IsInitialized() || request.ByteSizeLong() == 0) {
+            LOG_INFO("Skipping empty request");
+            return true;
+        }
+
+        LOG_INFO("Received CompositeRequest");
+
+        // 如果提供了请求处理器，调用它；否则使用默认的HandleRequest方法
+        bool keep_running = true;
+        if (request_handler) {
+            if (!request_handler(request)) {
+                LOG_INFO("Request handler requested loop exit");
+                keep_running = false;
+            }
+        } else {
+            if (!HandleRequest(request)) {
+                LOG_WARNING("Failed to handle request");
+            }
+        }
+
+        // 本次请求的响应已全部序列化，一次性释放 arena 上的消息
+        ResetResponseArena();
+        // 摘要时间预算按顶层请求计算
+        summary_time_spent_ = {};
+        return keep_running;
+    }
+
     void DebuggerClient::RunMessageLoop(
 
         const std::function<bool(const lldbprotobuf::Request &)> &request_handler
     ) {
+        if (reactor_.IsInitialized()) {
+            RunReactorLoop(request_handler);
+            return;
+        }
+
         LOG_INFO("Starting message loop");
 
+        // LLDB 事件由事件线程排队，在本线程的请求间隙处理；
+        // 等待请求时定期醒来处理事件，socket 可读后只读取一次，帧不完整时不阻塞
+        lldbprotobuf::Request request;
         while (tcp_client_.IsConnected()) {
-            lldbprotobuf::Request request;
+            DrainQueuedEvents();
+
+            if (!tcp_client_.HasBufferedRequests()) {
+                const int ready = tcp_client_.WaitReadable(QUEUED_EVENT_POLL_INTERVAL_MS);
+                if (ready < 0) {
+                    break;
+                }
+                if (ready > 0 && !tcp_client_.ReceiveAvailable()) {
+                    LOG_INFO("Failed to receive request or connection closed");
+                    break;
+                }
+                continue;
+            }
+
             if (!tcp_client_.ReceiveProtoMessage(request)) {
                 LOG_INFO("Failed to receive request or connection closed");
                 break;
             }
 
-            // 检查是否为空消息（size 0），如果是则跳过处理
-            if (!request.IsInitialized() || request.ByteSizeLong() == 0) {
-                LOG_INFO("Skipping empty request");
-                continue;
+            if (!DispatchRequest(request, request_handler)) {
+                break;
             }
+        }
 
-            LOG_INFO("Received CompositeRequest");
+        LOG_INFO("Message loop ended");
+    }
 
-            // 如果提供了请求处理器，调用它；否则使用默认的HandleRequest方法
-            if (request_handler) {
-                if (!request_handler(request)) {
-                    LOG_INFO("Request handler requested loop exit");
-                    break;
+    void DebuggerClient::DrainQueuedEvents() {
+        std::vector<std::pair<uint64_t, lldb::SBEvent>> events;
+        {
+            std::lock_guard<std::mutex> lock(queued_events_mutex_);
+            if (queued_events_.empty()) {
+                return;
+            }
+            events.swap(queued_events_);
+        }
+        for (auto &[sequence, event]: events) {
+            HandlePulledEvent(sequence, event);
+        }
+    }
+
+    void DebuggerClient::HandlePulledEvent(uint64_t sequence, lldb::SBEvent &event) {
+        HandleEvent(event);
+        if (breakpoint_manager_) {
+            breakpoint_manager_->ReleaseRetiredConditions(sequence);
+        }
+    }
+
+    void DebuggerClient::RunReactorLoop(
+        const std::function<bool(const lldbprotobuf::Request &)> &request_handler
+    ) {
+        LOG_INFO("Starting reactor message loop");
+
+        const auto socket_fd = static_cast<int>(tcp_client_.GetSocket());
+        bool registered = reactor_.AddReadable(socket_fd, [this, &request_handler]() {
+            // 每次可读通知只做一次非阻塞读取；帧不完整时直接返回事件循环，等待后续数据
+            if (!tcp_client_.ReceiveAvailable()) {
+                LOG_INFO("Failed to receive request or connection closed");
+                reactor_.Stop();
+                return;
+            }
+
+            // 一次读取可能解码出多个请求，全部处理完再返回事件循环
+            lldbprotobuf::Request request;
+            while (tcp_client_.HasBufferedRequests()) {
+                if (!tcp_client_.ReceiveProtoMessage(request)) {
+                    reactor_.Stop();
+                    return;
                 }
-            } else {
-                if (!HandleRequest(request)) {
-                    LOG_WARNING("Failed to handle request");
+
+                if (!DispatchRequest(request, request_handler)) {
+                    reactor_.Stop();
+                    return;
                 }
             }
-        }
+        });
+        if (!registered) {
+            LOG_ERROR("Failed to register socket with event reactor");
+            return;
+        }
+
+        // 定期输出发送队列积压情况，便于判断瓶颈是否在 IDE 端
+        reactor_.AddTimer(std::chrono::seconds(10), [this]() {
+            const TcpSendStats stats = tcp_client_.GetSendStats();
+            if (stats.queue_depth > 0) {
+                LOG_WARNING("Outbound queue backlog: " + std::to_string(stats.queue_depth) +
+                            " frames, max send latency: " + std::to_string(stats.max_latency_us) + " us");
+            }
+        }, true);
+
+        reactor_.Run();
+        reactor_.RemoveFd(socket_fd);
 
         LOG_INFO("Message loop ended");
     }
@@ -267,8 +412,13 @@ namespace Cangjie::Debugger {
         lldb_initialized_ = true;
         LOG_INFO("LLDB debugger initialized successfully");
 
-        // LLDB 初始化成功后，立即发送 InitializedEvent
-        if (!SendInitializedEvent()) {
+        // LLDB 初始化成功后，立即发送 InitializedEvent，并声明可选能力
+        constexpr uint64_t capabilities = lldbprotobuf::CAPABILITY_BATCH_REQUEST |
+                                          lldbprotobuf::CAPABILITY_STOP_SNAPSHOT |
+                                          lldbprotobuf::CAPABILITY_STRING_INTERN |
+                                          lldbprotobuf::CAPABILITY_EVALUATE_EXPRESSIONS |
+                                          lldbprotobuf::CAPABILITY_WATCH_SUBSCRIPTIONS;
+        if (!SendInitializedEvent(capabilities)) {
             LOG_ERROR("Failed to send InitializedEvent after LLDB initialization");
             // 注意：即使发送失败，LLDB 仍然已初始化，所以返回 true
         } else {
@@ -319,6 +469,8 @@ namespace Cangjie::Debugger {
         if (target_.IsValid()) {
             LOG_INFO("Cleaning up target");
             target_ = lldb::SBTarget();
+            type_cache_.Clear();
+            scope_cache_.Clear();
         }
 
         // 第三步: 清理断点管理器
@@ -333,7 +485,6 @@ namespace Cangjie::Debugger {
         if (cleaned_vars > 0) {
             LOG_INFO("Cleaned up " + std::to_string(cleaned_vars) + " invalid variables during cleanup");
         }
-        variable_id_map_.clear();
 
         // 第五步: 清理调试器
         if (lldb_initialized_ && debugger_.IsValid()) {
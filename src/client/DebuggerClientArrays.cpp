@@ -0,0 +1,214 @@
+/*
+ * Copyright 2025 LinQingYing. and contributors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * The use of this source code is governed by the Apache License 2.0,
+ * which allows users to freely use, modify, and distribute the code,
+ * provided they adhere to the terms of the license.
+ *
+ * The software is provided "as-is", and the authors are not responsible for
+ * any damages or issues arising from its use.
+ *
+ */
+
+#include "cangjie/debugger/DebuggerClient.h"
+#include "cangjie/debugger/ProtoConverter.h"
+#include "cangjie/debugger/CangjieFormatters.h"
+#include "cangjie/debugger/PrimitiveArrayDecoder.h"
+#include "cangjie/debugger/Logger.h"
+
+#include <cstring>
+#include <vector>
+
+namespace Cangjie::Debugger {
+    namespace {
+        // 子变量窗口至少包含这么多元素时才尝试批量读取，小窗口逐个获取的开销可以忽略
+        constexpr uint32_t BULK_CHILDREN_MIN_COUNT = 16;
+
+        std::string ExpressionPathOf(lldb::SBValue &value) {
+            lldb::SBStream stream;
+            if (value.GetExpressionPath(stream) && stream.GetData() != nullptr) {
+                return std::string(stream.GetData(), stream.GetSize());
+            }
+            return {};
+        }
+    }
+
+    bool DebuggerClient::FillContiguousArrayChildren(lldb::SBValue &parent_value, uint32_t start_idx,
+                                                     uint32_t end_idx, uint64_t thread_id, uint32_t frame_index,
+                                                     VariableList *children) const {
+        if (end_idx <= start_idx || end_idx - start_idx < BULK_CHILDREN_MIN_COUNT) {
+            return false;
+        }
+        const uint32_t count = end_idx - start_idx;
+
+        // 只探测窗口的首、次、末三个元素：类型一致且地址按元素宽度等距，即视为连续存储
+        lldb::SBValue first = parent_value.GetChildAtIndex(start_idx);
+        lldb::SBValue second = parent_value.GetChildAtIndex(start_idx + 1);
+        lldb::SBValue last = parent_value.GetChildAtIndex(end_idx - 1);
+        if (!first.IsValid() || !second.IsValid() || !last.IsValid()) {
+            return false;
+        }
+        // 用户为元素指定了显示格式时按 LLDB 的格式化结果为准
+        if (first.GetFormat() != lldb::eFormatDefault) {
+            return false;
+        }
+
+        const std::optional<PrimitiveLayout> layout = PrimitiveArrayDecoder::ClassifyType(first.GetType());
+        if (!layout.has_value()) {
+            return false;
+        }
+        const char *first_type = first.GetTypeName();
+        const char *last_type = last.GetTypeName();
+        if (first_type == nullptr || last_type == nullptr || std::strcmp(first_type, last_type) != 0) {
+            return false;
+        }
+
+        const lldb::addr_t base = first.GetLoadAddress();
+        const uint64_t stride = layout->byte_size;
+        if (base == LLDB_INVALID_ADDRESS ||
+            second.GetLoadAddress() != base + stride ||
+            last.GetLoadAddress() != base + static_cast<uint64_t>(count - 1) * stride) {
+            return false;
+        }
+
+        // 子变量 ID 按 "父路径[下标]" 计算，要求与 LLDB 给出的元素路径一致，
+        // 这样逐个获取和批量获取得到相同的 ID，且句柄可以按路径重建
+        const std::string parent_path = ExpressionPathOf(parent_value);
+        const std::string first_name = "[" + std::to_string(start_idx) + "]";
+        if (parent_path.empty() || ExpressionPathOf(first) != parent_path + first_name) {
+            return false;
+        }
+
+        const VariableScope scope = ResolveVariableScope(thread_id, frame_index, parent_value.GetFrame());
+        return FillDecodedChildren(parent_path, scope, first, *layout, base, start_idx, count, children);
+    }
+
+    bool DebuggerClient::FillDecodedChildren(const std::string &parent_path, const VariableScope &scope,
+                                             lldb::SBValue &first, const PrimitiveLayout &layout,
+                                             lldb::addr_t window_base, uint32_t start_idx, uint32_t count,
+                                             VariableList *children) const {
+        const uint64_t stride = layout.byte_size;
+        std::vector<uint8_t> buffer(static_cast<size_t>(count) * stride);
+        lldb::SBError error;
+        const size_t bytes_read = process_.ReadMemory(window_base, buffer.data(), buffer.size(), error);
+        if (error.Fail() || bytes_read != buffer.size()) {
+            LOG_WARNING("Bulk array read failed at address " + std::to_string(window_base) +
+                ", falling back to per-element");
+            return false;
+        }
+
+        std::vector<std::string> values;
+        const bool swap_bytes = process_.GetByteOrder() != PrimitiveArrayDecoder::HostByteOrder();
+        if (!PrimitiveArrayDecoder::Decode(layout, swap_bytes, buffer.data(), count, &values)) {
+            return false;
+        }
+
+        // 所有元素共享同一份类型和值分类，只转换一次
+        lldbprotobuf::Variable prototype;
+        ProtoConverter::FillVariable(&prototype, first, 0, &type_cache_);
+        prototype.set_has_children(false);
+
+        children->Reserve(static_cast<int>(count));
+        for (uint32_t i = 0; i < count; ++i) {
+            std::string name = "[" + std::to_string(start_idx + i) + "]";
+            const uint64_t child_id = AcquireVariableId(scope, parent_path + name, lldb::SBValue());
+
+            lldbprotobuf::Variable *child = children->Add();
+            *child = prototype;
+            child->mutable_id()->set_id(child_id);
+            child->set_name(std::move(name));
+            child->set_address(window_base + static_cast<uint64_t>(i) * stride);
+
+            lldbprotobuf::Value *value = child->mutable_value();
+            value->mutable_variable_id()->set_id(child_id);
+            value->set_value(std::move(values[i]));
+            TrackValueChange(child_id, buffer.data() + static_cast<size_t>(i) * stride,
+                             static_cast<size_t>(stride), value);
+        }
+
+        LOG_INFO("Bulk-read " + std::to_string(count) + " array elements (" + std::to_string(buffer.size()) +
+            " bytes) of '" + parent_path + "' with a single memory read");
+        return true;
+    }
+
+    bool DebuggerClient::FillSequenceChildren(lldb::SBValue &parent_value,
+                                              const CangjieFormatters::Sequence &sequence,
+                                              uint32_t start_idx, uint32_t end_idx, uint64_t thread_id,
+                                              uint32_t frame_index,
+                                              VariableList *children) const {
+        if (end_idx <= start_idx) {
+            return true;
+        }
+        const std::string parent_path = ExpressionPathOf(parent_value);
+        if (parent_path.empty()) {
+            return false;
+        }
+
+        const uint32_t count = end_idx - start_idx;
+        const uint64_t stride = sequence.stride;
+        const lldb::addr_t window_base = sequence.base + static_cast<uint64_t>(start_idx) * stride;
+        // 子变量 ID 按 "父路径[下标]" 计算，句柄过期或被淘汰后按该路径重建。
+        // 先确认 LLDB 能按此路径定位到窗口首元素，否则（如 ArrayList 等无法按下标路径访问的布局）
+        // 交给通用子变量路径处理
+        lldb::SBFrame frame = parent_value.GetFrame();
+        const std::string first_path = parent_path + "[" + std::to_string(start_idx) + "]";
+        lldb::SBValue probe = frame.IsValid() ? frame.GetValueForVariablePath(first_path.c_str()) : lldb::SBValue();
+        if (!probe.IsValid() || probe.GetError().Fail() || probe.GetLoadAddress() != window_base) {
+            LOG_INFO("Element path '" + first_path + "' does not resolve to the sequence storage, "
+                "using generic children");
+            return false;
+        }
+
+        const VariableScope scope = ResolveVariableScope(thread_id, frame_index, frame);
+
+        lldb::SBValue first = parent_value.CreateValueFromAddress(("[" + std::to_string(start_idx) + "]").c_str(),
+                                                                  window_base, sequence.element_type);
+        if (!first.IsValid()) {
+            return false;
+        }
+
+        // 基本类型元素：整个窗口一次读取
+        const std::optional<PrimitiveLayout> layout = PrimitiveArrayDecoder::ClassifyType(sequence.element_type);
+        if (layout.has_value() && first.GetFormat() == lldb::eFormatDefault &&
+            FillDecodedChildren(parent_path, scope, first, *layout, window_base, start_idx, count, children)) {
+            return true;
+        }
+
+        // 其他元素：按地址直接构造，不经过合成子变量提供器逐个枚举
+        for (uint32_t i = 0; i < count; ++i) {
+            const std::string name = "[" + std::to_string(start_idx + i) + "]";
+            lldb::SBValue child_value = i == 0 ? first
+                                               : parent_value.CreateValueFromAddress(
+                                                   name.c_str(), window_base + static_cast<uint64_t>(i) * stride,
+                                                   sequence.element_type);
+            if (!child_value.IsValid()) {
+                continue;
+            }
+
+            const uint64_t child_id = AcquireVariableId(scope, parent_path + name, child_value);
+            lldbprotobuf::Variable *child_variable = children->Add();
+            try {
+                ProtoConverter::FillVariable(child_variable, child_value, child_id, &type_cache_);
+            } catch (const std::exception &e) {
+                children->RemoveLast();
+                LOG_WARNING("Failed to convert element " + name + ": " + e.what());
+            }
+        }
+
+        LOG_INFO("Read " + std::to_string(children->size()) + " elements of '" + parent_path +
+            "' by address");
+        return true;
+    }
+}
@@ -0,0 +1,216 @@
+/*
+ * Copyright 2025 LinQingYing. and contributors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * The use of this source code is governed by the Apache License 2.0,
+ * which allows users to freely use, modify, and distribute the code,
+ * provided they adhere to the terms of the license.
+ *
+ * The software is provided "as-is", and the authors are not responsible for
+ * any damages or issues arising from its use.
+ *
+ */
+
+#include "cangjie/debugger/DebuggerClient.h"
+#include "cangjie/debugger/ProtoConverter.h"
+#include "cangjie/debugger/Logger.h"
+
+#include <google/protobuf/descriptor.h>
+
+namespace Cangjie::Debugger {
+    namespace {
+        /**
+         * @brief 批量执行期间安装响应收集器，离开作用域时恢复为直接发送
+         */
+        class BatchSinkGuard {
+        public:
+            BatchSinkGuard(lldbprotobuf::BatchResponse *&sink, lldbprotobuf::BatchResponse *batch) : sink_(sink) {
+                sink_ = batch;
+            }
+
+            ~BatchSinkGuard() {
+                sink_ = nullptr;
+            }
+
+            BatchSinkGuard(const BatchSinkGuard &) = delete;
+            BatchSinkGuard &operator=(const BatchSinkGuard &) = delete;
+
+        private:
+            lldbprotobuf::BatchResponse *&sink_;
+        };
+
+        /**
+         * @brief 设置子请求（oneof 中当前选中的请求消息）中指定名称的 Id 字段
+         * @return 子请求不包含该 Id 字段时返回 false
+         */
+        bool SetRequestIdField(lldbprotobuf::Request &request, const std::string &field_name, uint64_t id) {
+            const google::protobuf::OneofDescriptor *oneof = request.GetDescriptor()->FindOneofByName("request");
+            const google::protobuf::Reflection *reflection = request.GetReflection();
+            const google::protobuf::FieldDescriptor *active = reflection->GetOneofFieldDescriptor(request, oneof);
+            if (active == nullptr || active->message_type() == nullptr) {
+                return false;
+            }
+
+            google::protobuf::Message *payload = reflection->MutableMessage(&request, active);
+            const google::protobuf::FieldDescriptor *field = payload->GetDescriptor()->FindFieldByName(field_name);
+            if (field == nullptr || field->message_type() != lldbprotobuf::Id::descriptor()) {
+                return false;
+            }
+
+            auto *id_field = static_cast<lldbprotobuf::Id *>(payload->GetReflection()->MutableMessage(payload, field));
+            id_field->set_id(id);
+            return true;
+        }
+    }
+
+    bool DebuggerClient::ResolveBatchReference(const lldbprotobuf::BatchReference &reference,
+                                               const lldbprotobuf::BatchResponse &batch, const int entry_index,
+                                               lldbprotobuf::Request &sub_request, std::string &error_message) const {
+        const bool wants_thread = reference.field() == lldbprotobuf::BATCH_REFERENCE_FIELD_THREAD_ID;
+        uint64_t id = 0;
+
+        switch (reference.source_case()) {
+            case lldbprotobuf::BatchReference::kStoppedThread: {
+                if (!wants_thread) {
+                    error_message = "stopped_thread can only be referenced as thread_id";
+                    return false;
+                }
+                lldb::SBThread thread = process_.IsValid() ? process_.GetSelectedThread() : lldb::SBThread();
+                if (!thread.IsValid()) {
+                    error_message = "No stopped thread available";
+                    return false;
+                }
+                id = thread.GetThreadID();
+                break;
+            }
+            case lldbprotobuf::BatchReference::kResult: {
+                const lldbprotobuf::BatchResultRef &ref = reference.result();
+                // 下标按无符号比较，避免 2^31 以上的值转成负数后绕过越界检查
+                if (ref.entry_index() >= static_cast<uint32_t>(entry_index) ||
+                    ref.entry_index() >= static_cast<uint32_t>(batch.responses_size())) {
+                    error_message = "Reference to entry " + std::to_string(ref.entry_index()) +
+                                    " which has not been executed";
+                    return false;
+                }
+
+                const lldbprotobuf::Response &referenced = batch.responses(static_cast<int>(ref.entry_index()));
+                const uint32_t item = ref.item_index();
+                bool found = false;
+                switch (referenced.response_case()) {
+                    case lldbprotobuf::Response::kThreads:
+                        if (wants_thread && item < static_cast<uint32_t>(referenced.threads().threads_size())) {
+                            id = referenced.threads().threads(static_cast<int>(item)).thread_id().id();
+                            found = true;
+                        }
+                        break;
+                    case lldbprotobuf::Response::kVariables:
+                        if (!wants_thread && item < static_cast<uint32_t>(referenced.variables().variables_size())) {
+                            id = referenced.variables().variables(static_cast<int>(item)).id().id();
+                            found = true;
+                        }
+                        break;
+                    case lldbprotobuf::Response::kGetVariablesChildren:
+                        if (!wants_thread &&
+                            item < static_cast<uint32_t>(referenced.get_variables_children().children_size())) {
+                            id = referenced.get_variables_children().children(static_cast<int>(item)).id().id();
+                            found = true;
+                        }
+                        break;
+                    default:
+                        break;
+                }
+                if (!found) {
+                    error_message = "Entry " + std::to_string(ref.entry_index()) + " has no " +
+                                    (wants_thread ? "thread" : "variable") + " result at index " +
+                                    std::to_string(ref.item_index());
+                    return false;
+                }
+                break;
+            }
+            default:
+                error_message = "Batch reference has no source";
+                return false;
+        }
+
+        if (!SetRequestIdField(sub_request, wants_thread ? "thread_id" : "variable_id", id)) {
+            error_message = std::string("Request has no ") + (wants_thread ? "thread_id" : "variable_id") + " field";
+            return false;
+        }
+        return true;
+    }
+
+    bool DebuggerClient::HandleBatchRequest(const lldbprotobuf::BatchRequest &req,
+                                            const std::optional<uint64_t> hash) {
+        LOG_INFO("Handling Batch request: entries=" + std::to_string(req.entries_size()));
+
+        // 批量响应与所有子响应都构造在同一个响应 arena 上，子响应追加时无需拷贝
+        lldbprotobuf::Response *response = NewArenaResponse(hash);
+        lldbprotobuf::BatchResponse *batch_resp = response->mutable_batch();
+
+        std::string error_message;
+        int failed_index = -1;
+        {
+            BatchSinkGuard guard(batch_sink_, batch_resp);
+
+            for (int i = 0; i < req.entries_size(); ++i) {
+                const lldbprotobuf::BatchEntry &entry = req.entries(i);
+                if (entry.request().has_batch()) {
+                    error_message = "Nested BatchRequest is not supported";
+                    failed_index = i;
+                    break;
+                }
+
+                const int response_count = batch_resp->responses_size();
+                if (entry.references_size() == 0) {
+                    HandleRequest(entry.request());
+                } else {
+                    // 有引用时在副本上填充 Id 字段，保持原请求不变
+                    lldbprotobuf::Request sub_request = entry.request();
+                    bool resolved = true;
+                    for (const auto &reference: entry.references()) {
+                        if (!ResolveBatchReference(reference, *batch_resp, i, sub_request, error_message)) {
+                            resolved = false;
+                            break;
+                        }
+                    }
+                    if (!resolved) {
+                        failed_index = i;
+                        break;
+                    }
+                    HandleRequest(sub_request);
+                }
+
+                // 保证子响应与子请求按下标一一对应，后续引用依赖这一点
+                if (batch_resp->responses_size() == response_count) {
+                    LOG_WARNING("Batch entry " + std::to_string(i) + " produced no response");
+                    batch_resp->add_responses()->mutable_hash()->set_hash(entry.request().hash());
+                }
+                while (batch_resp->responses_size() > response_count + 1) {
+                    LOG_WARNING("Batch entry " + std::to_string(i) + " produced extra responses, keeping the first");
+                    batch_resp->mutable_responses()->RemoveLast();
+                }
+            }
+        }
+
+        if (failed_index >= 0) {
+            error_message = "Batch entry " + std::to_string(failed_index) + ": " + error_message;
+            LOG_ERROR(error_message);
+        }
+        ProtoConverter::FillResponseStatus(batch_resp->mutable_status(), failed_index < 0, error_message);
+
+        LOG_INFO("Batch request completed: " + std::to_string(batch_resp->responses_size()) + "/" +
+            std::to_string(req.entries_size()) + " entries executed");
+        return SendArenaResponse(response);
+    }
+}
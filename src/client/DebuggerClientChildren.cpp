@@ -0,0 +1,143 @@
+/*
+ * Copyright 2025 LinQingYing. and contributors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * The use of this source code is governed by the Apache License 2.0,
+ * which allows users to freely use, modify, and distribute the code,
+ * provided they adhere to the terms of the license.
+ *
+ * The software is provided "as-is", and the authors are not responsible for
+ * any damages or issues arising from its use.
+ *
+ */
+
+#include "cangjie/debugger/DebuggerClient.h"
+#include "cangjie/debugger/ProtoConverter.h"
+#include "cangjie/debugger/Logger.h"
+
+#include <algorithm>
+#include <deque>
+#include <utility>
+
+namespace Cangjie::Debugger {
+    namespace {
+        // 请求未指定 max_children 时，内联展开的每一层最多包含的子变量数
+        constexpr uint32_t DEFAULT_SUBTREE_MAX_CHILDREN = 100;
+        // 内联展开的最大层数，超出部分忽略
+        constexpr uint32_t MAX_SUBTREE_DEPTH = 16;
+        // 单个响应中内联展开的变量节点总数上限（含第一层）
+        constexpr uint32_t SUBTREE_NODE_BUDGET = 5000;
+    }
+
+    uint32_t DebuggerClient::FillChildWindow(lldb::SBValue &parent_value, uint32_t offset, uint32_t count,
+                                             uint64_t thread_id, uint32_t frame_index,
+                                             VariableList *children) const {
+        // Cangjie 序列按运行时布局直接定位元素，元素个数取自对象头而非 LLDB 的子节点枚举
+        const std::optional<CangjieFormatters::Sequence> sequence = CangjieFormatters::ResolveSequence(parent_value);
+        uint32_t total_children = sequence.has_value()
+                                      ? static_cast<uint32_t>(std::min<uint64_t>(sequence->length, UINT32_MAX))
+                                      : parent_value.GetNumChildren();
+        uint32_t start_idx = std::min(offset, total_children);
+        uint32_t end_idx = start_idx + std::min(count, total_children - start_idx);
+
+        LOG_INFO("Variable has " + std::to_string(total_children) + " children, returning " +
+            std::to_string(end_idx - start_idx) + " from index " + std::to_string(start_idx) +
+            " (thread_id=" + std::to_string(thread_id) + ", frame_index=" + std::to_string(frame_index) + ")");
+
+        if (sequence.has_value()) {
+            if (FillSequenceChildren(parent_value, *sequence, start_idx, end_idx, thread_id, frame_index, children)) {
+                return total_children;
+            }
+            // 布局解析与实际对象不符时按 LLDB 的子节点重新计算窗口
+            children->Clear();
+            total_children = parent_value.GetNumChildren();
+            start_idx = std::min(offset, total_children);
+            end_idx = start_idx + std::min(count, total_children - start_idx);
+        }
+
+        // 基本类型连续数组：一次内存读取得到整个窗口
+        if (FillContiguousArrayChildren(parent_value, start_idx, end_idx, thread_id, frame_index, children)) {
+            return total_children;
+        }
+
+        // 获取指定范围的子变量
+        for (uint32_t i = start_idx; i < end_idx; ++i) {
+            lldb::SBValue child_value = parent_value.GetChildAtIndex(i);
+            if (!child_value.IsValid()) {
+                continue;
+            }
+
+            try {
+                uint64_t child_id = AllocateVariableId(thread_id, frame_index, child_value);
+
+                // 创建子变量信息
+                lldbprotobuf::Variable *child_variable = children->Add();
+                try {
+                    ProtoConverter::FillVariable(child_variable, child_value, child_id, &type_cache_);
+                } catch (...) {
+                    children->RemoveLast();
+                    throw;
+                }
+
+                LOG_INFO("  Child: " + std::string(child_value.GetName() ? child_value.GetName() : "unnamed") +
+                    " (" + std::string(child_value.GetTypeName() ? child_value.GetTypeName() : "unknown") + ")");
+            } catch (const std::exception &e) {
+                LOG_WARNING("Failed to convert child variable at index " + std::to_string(i) + ": " + e.what());
+                // 继续处理其他子变量，不要因为一个失败而中断
+            }
+        }
+        return total_children;
+    }
+
+    void DebuggerClient::ExpandChildSubtrees(VariableList *roots, uint32_t max_depth, uint32_t max_children,
+                                             uint64_t thread_id, uint32_t frame_index) const {
+        max_depth = std::min(max_depth, MAX_SUBTREE_DEPTH);
+        const uint32_t per_level = max_children > 0 ? max_children : DEFAULT_SUBTREE_MAX_CHILDREN;
+        uint32_t budget = SUBTREE_NODE_BUDGET - std::min<uint32_t>(roots->size(), SUBTREE_NODE_BUDGET);
+
+        // 广度优先展开：节点预算不足时优先保证浅层完整
+        std::deque<std::pair<lldbprotobuf::Variable *, uint32_t>> pending;
+        for (auto &root: *roots) {
+            pending.emplace_back(&root, 1);
+        }
+
+        uint32_t expanded = 0;
+        while (!pending.empty() && budget > 0) {
+            auto [variable, depth] = pending.front();
+            pending.pop_front();
+            if (depth >= max_depth || !variable->has_children()) {
+                continue;
+            }
+
+            lldb::SBValue value = FindVariableById(variable->id().id());
+            if (!value.IsValid()) {
+                continue;
+            }
+
+            VariableList *children = variable->mutable_children();
+            variable->set_total_children(FillChildWindow(value, 0, std::min(per_level, budget), thread_id,
+                                                         frame_index, children));
+            budget -= std::min<uint32_t>(children->size(), budget);
+            ++expanded;
+
+            for (auto &child: *children) {
+                pending.emplace_back(&child, depth + 1);
+            }
+        }
+
+        LOG_INFO("Expanded " + std::to_string(expanded) + " variables inline (max_depth=" +
+            std::to_string(max_depth) + ", per-level cap=" + std::to_string(per_level) +
+            ", remaining node budget=" + std::to_string(budget) + ")");
+    }
+}
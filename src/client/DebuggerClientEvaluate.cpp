@@ -0,0 +1,361 @@
+/*
+ * Copyright 2025 LinQingYing. and contributors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * The use of this source code is governed by the Apache License 2.0,
+ * which allows users to freely use, modify, and distribute the code,
+ * provided they adhere to the terms of the license.
+ *
+ * The software is provided "as-is", and the authors are not responsible for
+ * any damages or issues arising from its use.
+ *
+ */
+
+#include "cangjie/debugger/DebuggerClient.h"
+#include "cangjie/debugger/ProtoConverter.h"
+#include "cangjie/debugger/Logger.h"
+#include "cangjie/debugger/VariablePathParser.h"
+
+#include <chrono>
+#include <utility>
+#include <vector>
+
+namespace Cangjie::Debugger {
+    namespace {
+        // 请求未指定超时时的求值硬截止时间
+        constexpr uint32_t DEFAULT_EVALUATE_DEADLINE_MS = 10000;
+        // 硬截止时间在 LLDB 超时之外的宽限，留给 LLDB 自行超时并回退线程状态
+        constexpr uint32_t EVALUATE_DEADLINE_GRACE_MS = 1000;
+        // 停止事件中附带的监视值字符串最大长度
+        constexpr uint32_t WATCH_VALUE_MAX_LENGTH = 1000;
+
+        std::string ElapsedMicroseconds(const std::chrono::steady_clock::time_point start) {
+            return std::to_string(std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - start).count());
+        }
+    }
+
+    bool DebuggerClient::ResolveEvaluationFrame(const bool has_thread_id, const uint64_t thread_id,
+                                                const uint32_t frame_index, lldb::SBThread &thread,
+                                                lldb::SBFrame &frame, std::string &error_message) const {
+        if (!process_.IsValid()) {
+            error_message = "No valid process available";
+            return false;
+        }
+
+        if (has_thread_id) {
+            thread = FindThreadById(thread_id);
+            if (!thread.IsValid()) {
+                error_message = "Thread not found";
+                return false;
+            }
+        } else {
+            // 如果没有指定线程，使用当前选中的线程
+            thread = process_.GetSelectedThread();
+            if (!thread.IsValid()) {
+                error_message = "No selected thread available";
+                return false;
+            }
+        }
+
+        if (frame_index != 0) {
+            const uint32_t num_frames = thread.GetNumFrames();
+            if (frame_index >= num_frames) {
+                error_message = "Frame index out of range";
+                return false;
+            }
+        }
+        frame = thread.GetFrameAtIndex(frame_index);
+        if (!frame.IsValid()) {
+            error_message = "Invalid frame";
+            return false;
+        }
+        return true;
+    }
+
+    bool DebuggerClient::EvaluateInFrame(lldb::SBThread &thread, lldb::SBFrame &frame, const std::string &expression,
+                                         const lldbprotobuf::EvaluateRequest &options,
+                                         lldbprotobuf::EvaluateResponse *evaluate_resp,
+                                         const std::optional<VariablePath> *parsed_path,
+                                         const uint32_t inline_value_length,
+                                         bool *transient_failure) const {
+        if (transient_failure != nullptr) {
+            *transient_failure = false;
+        }
+        const auto fail = [&](const std::string &error_message) {
+            LOG_ERROR("Expression '" + expression + "' failed: " + error_message);
+            evaluate_resp->clear_result();
+            ProtoConverter::FillResponseStatus(evaluate_resp->mutable_status(), false, error_message);
+            return false;
+        };
+        const auto start_time = std::chrono::steady_clock::now();
+
+        try {
+            // 简单变量路径（如悬停 obj.field[3]）直接在帧中查找，不经过表达式编译与 JIT
+            const std::optional<VariablePath> path = parsed_path != nullptr ? *parsed_path
+                                                                            : VariablePathParser::Parse(expression);
+            if (path.has_value()) {
+                lldb::SBValue value = path->is_identifier ? frame.FindVariable(path->path.c_str()) : lldb::SBValue();
+                if (!value.IsValid()) {
+                    value = frame.GetValueForVariablePath(path->path.c_str());
+                }
+                if (value.IsValid() && value.GetError().Success()) {
+                    // 结果就是帧中的变量本身，按其表达式路径分配 Id，与变量视图共享句柄
+                    const uint64_t variable_id = AllocateVariableId(thread.GetThreadID(), frame.GetFrameID(), value);
+                    evaluate_resp->set_evaluation_path(lldbprotobuf::EVALUATION_PATH_VARIABLE_PATH);
+                    ProtoConverter::FillVariable(evaluate_resp->mutable_result(), value, variable_id, &type_cache_);
+                    if (inline_value_length > 0) {
+                        *evaluate_resp->mutable_result()->mutable_value() =
+                                CreateBudgetedValue(value, variable_id, inline_value_length);
+                    }
+                    ProtoConverter::FillResponseStatus(evaluate_resp->mutable_status(), true);
+                    LOG_INFO("Expression '" + expression + "' resolved as variable path '" + path->path +
+                        "' in " + ElapsedMicroseconds(start_time) + " us");
+                    return true;
+                }
+                LOG_INFO("Variable path '" + path->path +
+                    "' not found in frame, falling back to expression evaluation");
+            }
+
+            evaluate_resp->set_evaluation_path(lldbprotobuf::EVALUATION_PATH_EXPRESSION);
+            lldb::SBExpressionOptions expression_options = CreateExpressionOptions(options);
+
+            // 硬截止时间：LLDB 的超时只约束目标代码的执行，编译阶段或运行所有线程时仍可能长时间阻塞，
+            // 到期后中断进程使 EvaluateExpression 返回
+            const uint32_t deadline_ms = (options.timeout_ms() > 0 ? options.timeout_ms()
+                                                                   : DEFAULT_EVALUATE_DEADLINE_MS) +
+                                         EVALUATE_DEADLINE_GRACE_MS;
+            lldb::SBValue result;
+            bool deadline_expired = false;
+            {
+                lldb::SBProcess process = process_;
+                DeadlineWatchdog::Scope deadline(evaluate_watchdog_, std::chrono::milliseconds(deadline_ms),
+                                                 [process]() mutable {
+                                                     LOG_WARNING("Expression evaluation exceeded its deadline, "
+                                                         "interrupting process");
+                                                     process.SendAsyncInterrupt();
+                                                 });
+                result = frame.EvaluateExpression(expression.c_str(), expression_options);
+                deadline_expired = deadline.Expired();
+            }
+
+            if (deadline_expired) {
+                if (transient_failure != nullptr) {
+                    *transient_failure = true;
+                }
+                return fail("Expression evaluation exceeded " + std::to_string(deadline_ms) +
+                            " ms and was interrupted");
+            }
+
+            // 禁用摘要时返回不经合成子变量提供器的原始值
+            if (options.disable_summaries() && result.IsValid()) {
+                result = result.GetNonSyntheticValue();
+            }
+
+            lldb::SBError error = result.GetError();
+            if (error.Fail()) {
+                const uint32_t code = error.GetError();
+                if (transient_failure != nullptr && error.GetType() == lldb::eErrorTypeExpression &&
+                    (code == static_cast<uint32_t>(lldb::eExpressionInterrupted) ||
+                     code == static_cast<uint32_t>(lldb::eExpressionTimedOut))) {
+                    *transient_failure = true;
+                }
+                return fail(std::string("Expression evaluation failed: ") +
+                            (error.GetCString() ? error.GetCString() : "unknown error"));
+            }
+            if (!result.IsValid()) {
+                return fail("Expression evaluation returned invalid result");
+            }
+
+            const uint64_t variable_id = AllocateVariableId(
+                thread.GetThreadID(),
+                frame.GetFrameID(),
+                result,
+                "$eval:" + expression); // 与同名局部变量区分：求值结果是值的副本
+            ProtoConverter::FillVariable(evaluate_resp->mutable_result(), result, variable_id, &type_cache_);
+            if (inline_value_length > 0) {
+                *evaluate_resp->mutable_result()->mutable_value() =
+                        CreateBudgetedValue(result, variable_id, inline_value_length);
+            }
+            ProtoConverter::FillResponseStatus(evaluate_resp->mutable_status(), true);
+
+            LOG_INFO("Expression evaluated successfully: '" + expression + "' = " +
+                (result.GetValue() ? std::string(result.GetValue()) : "<no value>") +
+                " in " + ElapsedMicroseconds(start_time) + " us");
+            return true;
+        } catch (const std::exception &e) {
+            return fail("Exception during expression evaluation: " + std::string(e.what()));
+        } catch (...) {
+            return fail("Unknown exception during expression evaluation");
+        }
+    }
+
+    bool DebuggerClient::HandleEvaluateExpressionsRequest(const lldbprotobuf::EvaluateExpressionsRequest &req,
+                                                          const std::optional<uint64_t> hash) const {
+        LOG_INFO("Handling EvaluateExpressions request: count=" + std::to_string(req.expressions_size()) +
+            ", thread_id=" + std::to_string(req.thread_id().id()) +
+            ", frame_index=" + std::to_string(req.frame_index()));
+
+        lldbprotobuf::Response *response = NewArenaResponse(hash);
+        lldbprotobuf::EvaluateExpressionsResponse *expressions_resp = response->mutable_evaluate_expressions();
+
+        lldb::SBThread thread;
+        lldb::SBFrame frame;
+        std::string error_message;
+        if (!ResolveEvaluationFrame(req.has_thread_id(), req.thread_id().id(), req.frame_index(), thread, frame,
+                                    error_message)) {
+            LOG_ERROR("EvaluateExpressions failed: " + error_message);
+            ProtoConverter::FillResponseStatus(expressions_resp->mutable_status(), false, error_message);
+            return SendArenaResponse(response);
+        }
+
+        // 缓存键：线程、帧、求值选项与表达式文本；停止 ID 由 StopCache 自身区分
+        const std::optional<uint32_t> stop_id = CurrentStopId();
+        std::string key_prefix;
+        if (stop_id) {
+            lldbprotobuf::EvaluateRequest key_options = req.options();
+            key_options.clear_expression();
+            key_prefix = std::to_string(thread.GetThreadID()) + ':' + std::to_string(req.frame_index()) + ':' +
+                         key_options.SerializeAsString() + ':';
+        }
+
+        uint32_t cache_hits = 0;
+        // 经表达式引擎求值的条目可能赋值或调用函数，与单个 EvaluateRequest 一样使值缓存失效；
+        // 此后的条目不再查询缓存，结果在失效之后写入
+        bool values_dirty = false;
+        std::vector<std::pair<std::string, const lldbprotobuf::EvaluateResponse *>> pending_stores;
+        expressions_resp->mutable_results()->Reserve(req.expressions_size());
+        for (const std::string &expression: req.expressions()) {
+            lldbprotobuf::EvaluateResponse *result = expressions_resp->add_results();
+            const std::string cache_key = stop_id ? key_prefix + expression : std::string();
+            if (stop_id && !values_dirty &&
+                stop_cache_.Lookup(*stop_id, StopCache::Kind::EVALUATIONS, cache_key, result)) {
+                result->set_from_cache(true);
+                ++cache_hits;
+                continue;
+            }
+
+            bool transient_failure = false;
+            EvaluateInFrame(thread, frame, expression, req.options(), result, nullptr, 0, &transient_failure);
+            if (result->evaluation_path() != lldbprotobuf::EVALUATION_PATH_VARIABLE_PATH) {
+                // 之前条目的结果可能已被本条的副作用改变，不再缓存
+                values_dirty = true;
+                pending_stores.clear();
+            }
+            // 失败结果同样缓存（同一停止点再次求值结果不变），超时、中断等暂时性失败除外
+            if (stop_id && !transient_failure) {
+                pending_stores.emplace_back(cache_key, result);
+            }
+        }
+
+        if (values_dirty) {
+            stop_cache_.InvalidateValues();
+        }
+        for (const auto &[cache_key, result]: pending_stores) {
+            stop_cache_.Store(*stop_id, StopCache::Kind::EVALUATIONS, cache_key, *result);
+        }
+
+        ProtoConverter::FillResponseStatus(expressions_resp->mutable_status(), true);
+        LOG_INFO("EvaluateExpressions completed: " + std::to_string(req.expressions_size()) + " expressions, " +
+            std::to_string(cache_hits) + " served from cache");
+        return SendArenaResponse(response);
+    }
+
+    bool DebuggerClient::HandleSubscribeWatchesRequest(const lldbprotobuf::SubscribeWatchesRequest &req,
+                                                       const std::optional<uint64_t> hash) const {
+        LOG_INFO("Handling SubscribeWatches request: count=" + std::to_string(req.watches_size()));
+
+        // 表达式只在订阅时解析一次，之后每次停止复用解析结果
+        std::vector<WatchSubscription> subscriptions;
+        subscriptions.reserve(req.watches_size());
+        for (const auto &watch: req.watches()) {
+            WatchSubscription subscription;
+            subscription.watch_id = watch.watch_id();
+            subscription.expression = watch.expression();
+            subscription.path = VariablePathParser::Parse(watch.expression());
+            subscriptions.push_back(std::move(subscription));
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(watch_mutex_);
+            watch_subscriptions_ = std::move(subscriptions);
+            watch_options_ = req.options();
+        }
+
+        lldbprotobuf::Response *response = NewArenaResponse(hash);
+        lldbprotobuf::SubscribeWatchesResponse *subscribe_resp = response->mutable_subscribe_watches();
+        ProtoConverter::FillResponseStatus(subscribe_resp->mutable_status(), true);
+        subscribe_resp->set_watch_count(static_cast<uint32_t>(req.watches_size()));
+        return SendArenaResponse(response);
+    }
+
+    void DebuggerClient::FillWatchResults(lldbprotobuf::ProcessStoppedDetails *details,
+                                          lldb::SBThread &stopped_thread) const {
+        std::lock_guard<std::mutex> lock(watch_mutex_);
+        if (watch_subscriptions_.empty()) {
+            return;
+        }
+        lldb::SBFrame frame = stopped_thread.GetFrameAtIndex(0);
+        if (!frame.IsValid()) {
+            return;
+        }
+
+        // 停止处理不属于任何请求，摘要时间预算单独计算，结束后恢复
+        const auto saved_summary_time = summary_time_spent_;
+        summary_time_spent_ = {};
+        uint32_t changed_count = 0;
+        bool values_dirty = false;
+        for (WatchSubscription &subscription: watch_subscriptions_) {
+            lldbprotobuf::WatchResult *watch = details->add_watches();
+            watch->set_watch_id(subscription.watch_id);
+
+            lldbprotobuf::EvaluateResponse evaluation;
+            EvaluateInFrame(stopped_thread, frame, subscription.expression, watch_options_, &evaluation,
+                            &subscription.path, WATCH_VALUE_MAX_LENGTH);
+            if (evaluation.evaluation_path() != lldbprotobuf::EVALUATION_PATH_VARIABLE_PATH) {
+                values_dirty = true;
+            }
+            *watch->mutable_status() = evaluation.status();
+            if (evaluation.has_result()) {
+                *watch->mutable_result() = std::move(*evaluation.mutable_result());
+            }
+
+            // 变化比较基于显示内容（值、摘要、错误），与变量 Id 是否跨帧变化无关
+            const lldbprotobuf::Value &value = watch->result().value();
+            std::string fingerprint = value.value();
+            fingerprint.push_back('\0');
+            fingerprint += value.summary();
+            fingerprint.push_back('\0');
+            fingerprint += watch->status().message();
+            const bool changed = subscription.last_fingerprint.has_value() &&
+                                 *subscription.last_fingerprint != fingerprint;
+            subscription.last_fingerprint = std::move(fingerprint);
+            watch->set_changed(changed);
+            if (watch->has_result()) {
+                watch->mutable_result()->mutable_value()->set_value_did_change(changed);
+            }
+            if (changed) {
+                ++changed_count;
+            }
+        }
+        summary_time_spent_ = saved_summary_time;
+        // 经表达式引擎求值的监视表达式可能有副作用，已缓存的快照等结果不再可靠
+        if (values_dirty) {
+            stop_cache_.InvalidateValues();
+        }
+
+        LOG_INFO("Evaluated " + std::to_string(watch_subscriptions_.size()) + " watch subscriptions on stop, " +
+            std::to_string(changed_count) + " changed");
+    }
+}
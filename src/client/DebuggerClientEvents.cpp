@@ -26,11 +26,20 @@
 #include "cangjie/debugger/ProtoConverter.h"
 #include "cangjie/debugger/Logger.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+
 namespace Cangjie::Debugger {
     // ============================================================================
     // Process Event Monitoring - Event Thread Implementation
     // ============================================================================
 
+    namespace {
+        // 唤醒广播器的事件位
+        constexpr uint32_t WAKEUP_BROADCAST_BIT = 1u << 0;
+    }
+
     void DebuggerClient::StartEventThread() {
         // 如果事件线程已经在运行,不要重复启动
         if (event_thread_running_.load()) {
@@ -44,6 +53,9 @@ namespace Cangjie::Debugger {
         // 设置所有事件监听器
         SetupAllEventListeners();
 
+        // 监听唤醒广播器，停止时用于打断阻塞的 WaitForEvent
+        wakeup_broadcaster_.AddListener(event_listener_, WAKEUP_BROADCAST_BIT);
+
         // 启动事件监听线程
         event_thread_ = std::thread(&DebuggerClient::EventThreadLoop, this);
 
@@ -54,6 +66,9 @@ namespace Cangjie::Debugger {
         // 设置停止标志
         event_thread_running_.store(false);
 
+        // 唤醒阻塞在 WaitForEvent 上的事件线程
+        wakeup_broadcaster_.BroadcastEventByType(WAKEUP_BROADCAST_BIT);
+
         // 等待线程退出
         if (event_thread_.joinable()) {
             event_thread_.join();
@@ -72,35 +87,31 @@ namespace Cangjie::Debugger {
 
         LOG_INFO("Event thread initialized, starting comprehensive event monitoring loop");
 
-        // 事件监听主循环
+        // 事件监听主循环：无限期阻塞等待事件（UINT32_MAX 表示不超时），停止时由唤醒广播器打断
         while (event_thread_running_.load()) {
             lldb::SBEvent event;
 
-            // 等待事件(1秒超时)
-            if (!event_listener_.WaitForEvent(1, event)) {
-                // 超时,检查进程状态
-                if (process_.IsValid()) {
-                    lldb::StateType state = process_.GetState();
-
-                    // 只在状态变化时记录
-                    if (state == lldb::eStateExited || state == lldb::eStateCrashed) {
-                        if (state == lldb::eStateExited) {
-                            int exit_code = process_.GetExitStatus();
-                            std::string exit_desc = process_.GetExitDescription() ? process_.GetExitDescription() : "";
-                            LOG_INFO("Process exited with code: " + std::to_string(exit_code));
-                        } else {
-                            LOG_ERROR("Process crashed");
-                        }
-                        // 进程已终止,可以退出事件循环
-                        break;
-                    }
-                }
+            if (!event_listener_.WaitForEvent(UINT32_MAX, event)) {
                 continue;
             }
 
+            // 断点回调已在取出事件时执行完毕，记录序号供请求线程判断何时可以释放被替换的条件程序
+            const uint64_t sequence = breakpoint_manager_->NotePulledEvent();
 
-            // 收到事件,使用综合事件处理器
-            HandleEvent(event);
+            if (event.BroadcasterMatchesRef(wakeup_broadcaster_)) {
+                continue;
+            }
+
+            // 收到事件，交给请求所在线程处理，与请求处理串行执行：
+            // 有事件循环时投递到事件循环，事件循环已停止时丢弃；否则排队等待消息循环处理
+            if (reactor_.IsInitialized()) {
+                if (!reactor_.Post([this, sequence, event]() mutable { HandlePulledEvent(sequence, event); })) {
+                    LOG_INFO("Event reactor stopped, dropping LLDB event");
+                }
+            } else {
+                std::lock_guard<std::mutex> lock(queued_events_mutex_);
+                queued_events_.emplace_back(sequence, event);
+            }
         }
 
         LOG_INFO("Event thread loop ended");
@@ -237,6 +248,15 @@ namespace Cangjie::Debugger {
                 break;
 
             case lldb::eStateStopped: {
+                // 条件为假或断点回调要求继续时，LLDB 已自动恢复运行：进程实际并未停下，
+                // 不建立快照、不求值监视表达式，也不广播停止
+                if (lldb::SBProcess::GetRestartedFromEvent(event)) {
+                    LOG_INFO("  → Stop was automatically restarted, ignoring");
+                    break;
+                }
+
+                // 每次停止建立一次线程索引，供后续请求共享
+                RefreshThreadIndex();
                 lldb::SBThread thread = process_.GetSelectedThread();
                 std::string description;
 
@@ -315,6 +335,9 @@ namespace Cangjie::Debugger {
 
             case lldb::eStateRunning: {
                 LOG_INFO("  → Process is running");
+                stop_cache_.Invalidate();
+                LogTypeCacheStats();
+                variable_handles_.BumpEpoch();
                 int64_t thread_id = 0;
                 lldb::SBThread thread = process_.GetSelectedThread();
                 if (thread.IsValid()) {
@@ -326,6 +349,8 @@ namespace Cangjie::Debugger {
 
             case lldb::eStateStepping: {
                 LOG_INFO("  → Process is stepping");
+                stop_cache_.Invalidate();
+                variable_handles_.BumpEpoch();
                 int64_t thread_id = 0;
                 lldb::SBThread thread = process_.GetSelectedThread();
                 if (thread.IsValid()) {
@@ -370,6 +395,8 @@ namespace Cangjie::Debugger {
                 if (!exit_description.empty()) {
                     LOG_INFO("  → Exit description: " + exit_description);
                 }
+                // 重新启动后函数加载地址可能变化
+                scope_cache_.Clear();
                 SendProcessStateChangedExited(state, "Process exited", exit_code, exit_description);
                 break;
             }
@@ -470,6 +497,9 @@ namespace Cangjie::Debugger {
             SendModuleLoadedEvent(modules);
         } else if (event_type & lldb::SBTarget::eBroadcastBitModulesUnloaded) {
             LOG_INFO("Modules unloaded");
+            // 卸载模块的类型与函数地址不再有效，重新加载后 UUID 可能对应不同的类型定义
+            type_cache_.Clear();
+            scope_cache_.Clear();
 
             std::vector<lldbprotobuf::Module> modules;
             uint32_t num_modules = target.GetNumModulesFromEvent(event);
@@ -714,11 +744,12 @@ namespace Cangjie::Debugger {
             capabilities
         );
 
-        lldbprotobuf::Event event;
-        *event.mutable_initialized() = initialized_event;
+        // 直接构造 Response 信封，避免再复制一次事件
+        lldbprotobuf::Response response;
+        *response.mutable_event()->mutable_initialized() = std::move(initialized_event);
 
 
-        return tcp_client_.SendEventBroadcast(event);
+        return tcp_client_.SendEventBroadcast(response);
     }
 
     // ========================================================================
@@ -732,13 +763,71 @@ namespace Cangjie::Debugger {
         lldb::SBFrame &current_frame) const {
         lldbprotobuf::ProcessStateChanged process_state_changed =
                 ProtoConverter::CreateProcessStateChangedStopped(state, description, stopped_thread, current_frame);
+        if (stop_snapshot_enabled_.load()) {
+            FillStopSnapshot(process_state_changed.mutable_stopped_details()->mutable_snapshot(), stopped_thread);
+        }
+        FillWatchResults(process_state_changed.mutable_stopped_details(), stopped_thread);
 
-        lldbprotobuf::Event event;
-        *event.mutable_process_state_changed() = process_state_changed;
+        lldbprotobuf::Response response;
+        *response.mutable_event()->mutable_process_state_changed() = std::move(process_state_changed);
 
         LOG_INFO("Broadcasting ProcessStateChanged (stopped): state=" +
             std::to_string(static_cast<int>(state)) + ", description=" + description);
-        return tcp_client_.SendEventBroadcast(event);
+        return tcp_client_.SendEventBroadcast(response);
+    }
+
+    void DebuggerClient::FillStopSnapshot(lldbprotobuf::StopSnapshot *snapshot, lldb::SBThread &stopped_thread) const {
+        // 所有线程
+        const uint32_t num_threads = process_.GetNumThreads();
+        for (uint32_t i = 0; i < num_threads; ++i) {
+            lldb::SBThread sb_thread = process_.GetThreadAtIndex(i);
+            if (sb_thread.IsValid()) {
+                ProtoConverter::FillThread(snapshot->add_threads(), sb_thread);
+            }
+        }
+
+        // 停止线程的顶层栈帧
+        const uint32_t total_frames = stopped_thread.GetNumFrames();
+        const uint32_t frame_count = std::min(total_frames, stop_snapshot_max_frames_.load());
+        snapshot->set_total_frames(total_frames);
+        for (uint32_t i = 0; i < frame_count; ++i) {
+            lldb::SBFrame sb_frame = stopped_thread.GetFrameAtIndex(i);
+            if (sb_frame.IsValid()) {
+                ProtoConverter::FillFrame(snapshot->add_frames(), sb_frame);
+            }
+        }
+
+        // 第 0 帧的第一页参数和局部变量，ID 与 Variables 请求共用同一映射表
+        lldb::SBFrame top_frame = stopped_thread.GetFrameAtIndex(0);
+        if (!top_frame.IsValid()) {
+            return;
+        }
+        lldb::SBValueList locals = top_frame.GetVariables(true, true, false, true);
+        const uint32_t total_locals = locals.GetSize();
+        const uint32_t max_locals = stop_snapshot_max_locals_.load();
+        snapshot->set_total_locals(total_locals);
+        for (uint32_t i = 0; i < total_locals && static_cast<uint32_t>(snapshot->locals_size()) < max_locals; ++i) {
+            lldb::SBValue sb_value = locals.GetValueAtIndex(i);
+            if (!sb_value.IsValid()) {
+                continue;
+            }
+            try {
+                uint64_t variable_id = AllocateVariableId(stopped_thread.GetThreadID(), 0, sb_value);
+                lldbprotobuf::Variable *variable = snapshot->add_locals();
+                try {
+                    ProtoConverter::FillVariable(variable, sb_value, variable_id, &type_cache_);
+                } catch (...) {
+                    snapshot->mutable_locals()->RemoveLast();
+                    throw;
+                }
+            } catch (const std::exception &e) {
+                LOG_WARNING("Failed to add snapshot variable at index " + std::to_string(i) + ": " + e.what());
+            }
+        }
+
+        LOG_INFO("Stop snapshot: threads=" + std::to_string(snapshot->threads_size()) +
+            ", frames=" + std::to_string(snapshot->frames_size()) +
+            ", locals=" + std::to_string(snapshot->locals_size()) + "/" + std::to_string(total_locals));
     }
 
     bool DebuggerClient::SendProcessStateChangedRunning(
@@ -748,12 +837,12 @@ namespace Cangjie::Debugger {
         lldbprotobuf::ProcessStateChanged process_state_changed =
                 ProtoConverter::CreateProcessStateChangedRunning(state, description, thread_id);
 
-        lldbprotobuf::Event event;
-        *event.mutable_process_state_changed() = process_state_changed;
+        lldbprotobuf::Response response;
+        *response.mutable_event()->mutable_process_state_changed() = std::move(process_state_changed);
 
         LOG_INFO("Broadcasting ProcessStateChanged (running): state=" +
             std::to_string(static_cast<int>(state)) + ", thread_id=" + std::to_string(thread_id));
-        return tcp_client_.SendEventBroadcast(event);
+        return tcp_client_.SendEventBroadcast(response);
     }
 
     bool DebuggerClient::SendProcessStateChangedExited(
@@ -764,12 +853,12 @@ namespace Cangjie::Debugger {
         lldbprotobuf::ProcessStateChanged process_state_changed =
                 ProtoConverter::CreateProcessStateChangedExited(state, description, exit_code, exit_description);
 
-        lldbprotobuf::Event event;
-        *event.mutable_process_state_changed() = process_state_changed;
+        lldbprotobuf::Response response;
+        *response.mutable_event()->mutable_process_state_changed() = std::move(process_state_changed);
 
         LOG_INFO("Broadcasting ProcessStateChanged (exited): state=" +
             std::to_string(static_cast<int>(state)) + ", exit_code=" + std::to_string(exit_code));
-        return tcp_client_.SendEventBroadcast(event);
+        return tcp_client_.SendEventBroadcast(response);
     }
 
     bool DebuggerClient::SendProcessStateChangedSimple(
@@ -778,26 +867,26 @@ namespace Cangjie::Debugger {
         lldbprotobuf::ProcessStateChanged process_state_changed =
                 ProtoConverter::CreateProcessStateChangedSimple(state, description);
 
-        lldbprotobuf::Event event;
-        *event.mutable_process_state_changed() = process_state_changed;
+        lldbprotobuf::Response response;
+        *response.mutable_event()->mutable_process_state_changed() = std::move(process_state_changed);
 
         LOG_INFO("Broadcasting ProcessStateChanged (simple): state=" +
             std::to_string(static_cast<int>(state)) + ", description=" + description);
-        return tcp_client_.SendEventBroadcast(event);
+        return tcp_client_.SendEventBroadcast(response);
     }
 
     bool DebuggerClient::SendProcessOutputEvent(const std::string &text, lldbprotobuf::OutputType output_type) const {
         // Use ProtoConverter to create ProcessOutput event
         lldbprotobuf::ProcessOutput process_output = ProtoConverter::CreateProcessOutputEvent(text, output_type);
 
-        // Create the event and send it
-        lldbprotobuf::Event event;
-        *event.mutable_process_output() = process_output;
+        // Create the event envelope and send it
+        lldbprotobuf::Response response;
+        *response.mutable_event()->mutable_process_output() = std::move(process_output);
 
         LOG_INFO(
             "Broadcasting ProcessOutput event: type=" + std::to_string(output_type) + ", length=" + std::to_string(text.
                 length()));
-        return tcp_client_.SendEventBroadcast(event);
+        return tcp_client_.SendEventBroadcast(response);
     }
 
     // 新增事件发送函数实现
@@ -808,11 +897,11 @@ namespace Cangjie::Debugger {
 
         lldbprotobuf::ModuleEvent module_event = ProtoConverter::CreateModuleLoadedEvent(modules);
 
-        lldbprotobuf::Event event;
-        *event.mutable_module_event() = module_event;
+        lldbprotobuf::Response response;
+        *response.mutable_event()->mutable_module_event() = std::move(module_event);
 
         LOG_INFO("Broadcasting ModuleLoaded event: " + std::to_string(modules.size()) + " modules");
-        return tcp_client_.SendEventBroadcast(event);
+        return tcp_client_.SendEventBroadcast(response);
     }
 
     bool DebuggerClient::SendModuleUnloadedEvent(const std::vector<lldbprotobuf::Module> &modules) const {
@@ -822,11 +911,11 @@ namespace Cangjie::Debugger {
 
         lldbprotobuf::ModuleEvent module_event = ProtoConverter::CreateModuleUnloadedEvent(modules);
 
-        lldbprotobuf::Event event;
-        *event.mutable_module_event() = module_event;
+        lldbprotobuf::Response response;
+        *response.mutable_event()->mutable_module_event() = std::move(module_event);
 
         LOG_INFO("Broadcasting ModuleUnloaded event: " + std::to_string(modules.size()) + " modules");
-        return tcp_client_.SendEventBroadcast(event);
+        return tcp_client_.SendEventBroadcast(response);
     }
 
     bool DebuggerClient::SendBreakpointChangedEvent(
@@ -836,12 +925,12 @@ namespace Cangjie::Debugger {
         lldbprotobuf::BreakpointChangedEvent bp_event = ProtoConverter::CreateBreakpointChangedEvent(
             breakpoint, change_type, description);
 
-        lldbprotobuf::Event event;
-        *event.mutable_breakpoint_changed_event() = bp_event;
+        lldbprotobuf::Response response;
+        *response.mutable_event()->mutable_breakpoint_changed_event() = std::move(bp_event);
 
         LOG_INFO("Broadcasting BreakpointChanged event: breakpoint_id=" + std::to_string(breakpoint.id().id()) +
             ", change_type=" + std::to_string(change_type));
-        return tcp_client_.SendEventBroadcast(event);
+        return tcp_client_.SendEventBroadcast(response);
     }
 
     bool DebuggerClient::SendThreadStateChangedEvent(
@@ -851,12 +940,12 @@ namespace Cangjie::Debugger {
         lldbprotobuf::ThreadStateChangedEvent thread_event = ProtoConverter::CreateThreadStateChangedEvent(
             thread, change_type, description);
 
-        lldbprotobuf::Event event;
-        *event.mutable_thread_state_changed_event() = thread_event;
+        lldbprotobuf::Response response;
+        *response.mutable_event()->mutable_thread_state_changed_event() = std::move(thread_event);
 
         LOG_INFO("Broadcasting ThreadStateChanged event: thread_id=" + std::to_string(thread.thread_id().id()) +
             ", change_type=" + std::to_string(change_type));
-        return tcp_client_.SendEventBroadcast(event);
+        return tcp_client_.SendEventBroadcast(response);
     }
 
     bool DebuggerClient::SendSymbolsLoadedEvent(
@@ -866,12 +955,12 @@ namespace Cangjie::Debugger {
         lldbprotobuf::SymbolsLoadedEvent symbols_event = ProtoConverter::CreateSymbolsLoadedEvent(
             module, symbol_count, symbol_file_path);
 
-        lldbprotobuf::Event event;
-        *event.mutable_symbols_loaded_event() = symbols_event;
+        lldbprotobuf::Response response;
+        *response.mutable_event()->mutable_symbols_loaded_event() = std::move(symbols_event);
 
         LOG_INFO("Broadcasting SymbolsLoaded event: module=" + module.name() +
             ", symbol_count=" + std::to_string(symbol_count));
-        return tcp_client_.SendEventBroadcast(event);
+        return tcp_client_.SendEventBroadcast(response);
     }
 
 
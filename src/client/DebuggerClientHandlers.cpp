@@ -26,7 +26,27 @@
 #include "cangjie/debugger/ProtoConverter.h"
 #include "cangjie/debugger/Logger.h"
 
+#include <cstring>
+
 namespace Cangjie::Debugger {
+    namespace {
+        /**
+         * @brief 比较两个文件规格是否指向同一文件
+         *
+         * 文件名与目录由 LLDB 驻留保存，同一字符串通常为同一指针，先比较指针再逐字比较，
+         * 不拼接完整路径。
+         */
+        bool IsSameFileSpec(const lldb::SBFileSpec &lhs, const lldb::SBFileSpec &rhs) {
+            if (!lhs.IsValid() || !rhs.IsValid()) {
+                return false;
+            }
+            const auto same = [](const char *a, const char *b) {
+                return a == b || (a != nullptr && b != nullptr && std::strcmp(a, b) == 0);
+            };
+            return same(lhs.GetFilename(), rhs.GetFilename()) && same(lhs.GetDirectory(), rhs.GetDirectory());
+        }
+    }
+
     bool DebuggerClient::HandleTerminateRequest(const std::optional<uint64_t> hash) const {
         LOG_INFO("Handling Terminate request");
         if (InitializeLLDB()) {
@@ -551,18 +571,8 @@ if (launch_info.disable_aslr()) {
         }
 
         // 查找指定的线程
-        lldb::SBThread target_thread;
-        uint32_t num_threads = process_.GetNumThreads();
-        bool thread_found = false;
-
-        for (uint32_t i = 0; i < num_threads; ++i) {
-            lldb::SBThread sb_thread = process_.GetThreadAtIndex(i);
-            if (sb_thread.IsValid() && sb_thread.GetThreadID() == req.thread_id().id()) {
-                target_thread = sb_thread;
-                thread_found = true;
-                break;
-            }
-        }
+        lldb::SBThread target_thread = FindThreadById(req.thread_id().id());
+        bool thread_found = target_thread.IsValid();
 
         if (!thread_found) {
             LOG_ERROR("Thread not found for step into: " + std::to_string(req.thread_id().id()));
@@ -597,18 +607,8 @@ if (launch_info.disable_aslr()) {
         }
 
         // 查找指定的线程
-        lldb::SBThread target_thread;
-        uint32_t num_threads = process_.GetNumThreads();
-        bool thread_found = false;
-
-        for (uint32_t i = 0; i < num_threads; ++i) {
-            lldb::SBThread sb_thread = process_.GetThreadAtIndex(i);
-            if (sb_thread.IsValid() && sb_thread.GetThreadID() == req.thread_id().id()) {
-                target_thread = sb_thread;
-                thread_found = true;
-                break;
-            }
-        }
+        lldb::SBThread target_thread = FindThreadById(req.thread_id().id());
+        bool thread_found = target_thread.IsValid();
 
         if (!thread_found) {
             LOG_ERROR("Thread not found for step over: " + std::to_string(req.thread_id().id()));
@@ -651,18 +651,8 @@ if (launch_info.disable_aslr()) {
         }
 
         // 查找指定的线程
-        lldb::SBThread target_thread;
-        uint32_t num_threads = process_.GetNumThreads();
-        bool thread_found = false;
-
-        for (uint32_t i = 0; i < num_threads; ++i) {
-            lldb::SBThread sb_thread = process_.GetThreadAtIndex(i);
-            if (sb_thread.IsValid() && sb_thread.GetThreadID() == req.thread_id().id()) {
-                target_thread = sb_thread;
-                thread_found = true;
-                break;
-            }
-        }
+        lldb::SBThread target_thread = FindThreadById(req.thread_id().id());
+        bool thread_found = target_thread.IsValid();
 
         if (!thread_found) {
             LOG_ERROR("Thread not found for step out: " + std::to_string(req.thread_id().id()));
@@ -703,18 +693,8 @@ if (launch_info.disable_aslr()) {
         }
 
         // 查找指定的线程
-        lldb::SBThread target_thread;
-        uint32_t num_threads = process_.GetNumThreads();
-        bool thread_found = false;
-
-        for (uint32_t i = 0; i < num_threads; ++i) {
-            lldb::SBThread sb_thread = process_.GetThreadAtIndex(i);
-            if (sb_thread.IsValid() && sb_thread.GetThreadID() == req.thread_id().id()) {
-                target_thread = sb_thread;
-                thread_found = true;
-                break;
-            }
-        }
+        lldb::SBThread target_thread = FindThreadById(req.thread_id().id());
+        bool thread_found = target_thread.IsValid();
 
         if (!thread_found) {
             LOG_ERROR("Thread not found for run to cursor: " + std::to_string(req.thread_id().id()));
@@ -936,6 +916,35 @@ if (launch_info.disable_aslr()) {
         }
     }
 
+    bool DebuggerClient::HandleConfigureStopSnapshotRequest(const lldbprotobuf::ConfigureStopSnapshotRequest &req,
+                                                            const std::optional<uint64_t> hash) {
+        constexpr uint32_t DEFAULT_SNAPSHOT_FRAMES = 20;
+        constexpr uint32_t DEFAULT_SNAPSHOT_LOCALS = 50;
+
+        const uint32_t max_frames = req.max_frames() > 0 ? req.max_frames() : DEFAULT_SNAPSHOT_FRAMES;
+        const uint32_t max_locals = req.max_locals() > 0 ? req.max_locals() : DEFAULT_SNAPSHOT_LOCALS;
+        LOG_INFO("Handling ConfigureStopSnapshot request: enabled=" + std::to_string(req.enabled()) +
+            ", max_frames=" + std::to_string(max_frames) + ", max_locals=" + std::to_string(max_locals));
+
+        stop_snapshot_max_frames_.store(max_frames);
+        stop_snapshot_max_locals_.store(max_locals);
+        stop_snapshot_enabled_.store(req.enabled());
+
+        return SendConfigureStopSnapshotResponse(true, max_frames, max_locals, "", hash);
+    }
+
+    bool DebuggerClient::HandleConfigureStringInternRequest(const lldbprotobuf::ConfigureStringInternRequest &req,
+                                                            const std::optional<uint64_t> hash) {
+        LOG_INFO("Handling ConfigureStringIntern request: enabled=" + std::to_string(req.enabled()) +
+            ", dropping " + std::to_string(string_intern_.Size()) + " interned strings");
+
+        // 客户端收到响应后会丢弃本地驻留表，服务端同步清空以保证 Id 对应关系一致
+        string_intern_.Reset();
+        string_intern_enabled_ = req.enabled();
+
+        return SendConfigureStringInternResponse(true, "", hash);
+    }
+
     bool DebuggerClient::HandleThreadsRequest(const lldbprotobuf::ThreadsRequest &req,
                                               const std::optional<uint64_t> hash) const {
         (void) req; // 当前请求没有参数需要处理
@@ -947,7 +956,17 @@ if (launch_info.disable_aslr()) {
             return SendThreadsResponse(false, {}, "No valid process available", hash);
         }
 
-        std::vector<lldbprotobuf::Thread> threads;
+        // 线程列表直接构造在 arena 上的响应中，避免中间 vector 及逐个拷贝
+        lldbprotobuf::Response *response = NewArenaResponse(hash);
+        lldbprotobuf::ThreadsResponse *threads_resp = response->mutable_threads();
+
+        const std::optional<uint32_t> stop_id = CurrentStopId();
+        if (stop_id && stop_cache_.Lookup(*stop_id, StopCache::Kind::THREADS, "", threads_resp)) {
+            LOG_INFO("Threads served from stop cache (stop_id=" + std::to_string(*stop_id) + ")");
+            return SendArenaResponse(response);
+        }
+
+        ProtoConverter::FillResponseStatus(threads_resp->mutable_status(), true);
 
         // 获取进程中的所有线程
         uint32_t num_threads = process_.GetNumThreads();
@@ -957,16 +976,18 @@ if (launch_info.disable_aslr()) {
             lldb::SBThread sb_thread = process_.GetThreadAtIndex(i);
             if (sb_thread.IsValid()) {
                 // 使用 ProtoConverter 将 LLDB 线程转换为 protobuf 线程
-                lldbprotobuf::Thread thread = ProtoConverter::CreateThread(sb_thread);
-                threads.push_back(thread);
+                ProtoConverter::FillThread(threads_resp->add_threads(), sb_thread);
 
                 LOG_INFO("  Thread " + std::to_string(i) + ": ID=" + std::to_string(sb_thread.GetThreadID()) +
                     ", Name=" + std::string(sb_thread.GetName() ? sb_thread.GetName() : "unnamed"));
             }
         }
 
-        LOG_INFO("Successfully retrieved " + std::to_string(threads.size()) + " threads");
-        return SendThreadsResponse(true, threads, "", hash);
+        LOG_INFO("Successfully retrieved " + std::to_string(threads_resp->threads_size()) + " threads");
+        if (stop_id) {
+            stop_cache_.Store(*stop_id, StopCache::Kind::THREADS, "", *threads_resp);
+        }
+        return SendArenaResponse(response);
     }
 
     bool DebuggerClient::HandleFramesRequest(const lldbprotobuf::FramesRequest &req,
@@ -982,28 +1003,33 @@ if (launch_info.disable_aslr()) {
             return SendFramesResponse(false, {}, 0, "No valid process available", hash);
         }
 
-        // 查找指定的线程
-        lldb::SBThread target_thread;
-        uint32_t num_threads = process_.GetNumThreads();
-        bool thread_found = false;
-
-        for (uint32_t i = 0; i < num_threads; ++i) {
-            lldb::SBThread sb_thread = process_.GetThreadAtIndex(i);
-            if (sb_thread.IsValid() && sb_thread.GetThreadID() == req.thread_id().id()) {
-                target_thread = sb_thread;
-                thread_found = true;
-                break;
+        // 进程未恢复运行时，相同请求直接返回缓存的栈帧
+        const std::optional<uint32_t> stop_id = CurrentStopId();
+        const std::string cache_key = stop_id ? req.SerializeAsString() : std::string();
+        if (stop_id) {
+            lldbprotobuf::Response *cached = NewArenaResponse(hash);
+            if (stop_cache_.Lookup(*stop_id, StopCache::Kind::FRAMES, cache_key, cached->mutable_frames())) {
+                LOG_INFO("Frames served from stop cache (stop_id=" + std::to_string(*stop_id) + ")");
+                return SendArenaResponse(cached);
             }
         }
 
+        // 查找指定的线程
+        lldb::SBThread target_thread = FindThreadById(req.thread_id().id());
+        bool thread_found = target_thread.IsValid();
+
         if (!thread_found) {
             LOG_ERROR("Thread not found: " + std::to_string(req.thread_id().id()));
             return SendFramesResponse(false, {}, 0, "Thread not found", hash);
         }
 
-        std::vector<lldbprotobuf::Frame> frames;
         uint32_t total_frames = target_thread.GetNumFrames();
 
+        lldbprotobuf::Response *response = NewArenaResponse(hash);
+        lldbprotobuf::FramesResponse *frames_resp = response->mutable_frames();
+        ProtoConverter::FillResponseStatus(frames_resp->mutable_status(), true);
+        frames_resp->set_total_frames(total_frames);
+
         // 辅助函数：检查帧是否有有效的源码行信息
         auto hasValidSourceLine = [](const lldb::SBFrame &frame) -> bool {
             if (!frame.IsValid()) {
@@ -1032,8 +1058,7 @@ if (launch_info.disable_aslr()) {
             for (uint32_t i = start_idx; i < search_end; ++i) {
                 lldb::SBFrame sb_frame = target_thread.GetFrameAtIndex(i);
                 if (sb_frame.IsValid() && hasValidSourceLine(sb_frame)) {
-                    lldbprotobuf::Frame frame = ProtoConverter::CreateFrame(sb_frame);
-                    frames.push_back(frame);
+                    ProtoConverter::FillFrame(frames_resp->add_frames(), sb_frame);
 
                     lldb::SBLineEntry line_entry = sb_frame.GetLineEntry();
                     LOG_INFO("Found first valid source frame at index " + std::to_string(i) +
@@ -1045,7 +1070,7 @@ if (launch_info.disable_aslr()) {
                 }
             }
 
-            if (frames.empty()) {
+            if (frames_resp->frames_size() == 0) {
                 LOG_INFO("No frame with valid source information found in requested range");
             }
         } else {
@@ -1059,8 +1084,7 @@ if (launch_info.disable_aslr()) {
             for (uint32_t i = start_idx; i < end_idx; ++i) {
                 lldb::SBFrame sb_frame = target_thread.GetFrameAtIndex(i);
                 if (sb_frame.IsValid()) {
-                    lldbprotobuf::Frame frame = ProtoConverter::CreateFrame(sb_frame);
-                    frames.push_back(frame);
+                    ProtoConverter::FillFrame(frames_resp->add_frames(), sb_frame);
 
                     LOG_INFO(
                         "  Frame " + std::to_string(i) + ": " + std::string(sb_frame.GetFunctionName() ? sb_frame.
@@ -1069,8 +1093,11 @@ if (launch_info.disable_aslr()) {
             }
         }
 
-        LOG_INFO("Successfully retrieved " + std::to_string(frames.size()) + " frames");
-        return SendFramesResponse(true, frames, total_frames, "", hash);
+        LOG_INFO("Successfully retrieved " + std::to_string(frames_resp->frames_size()) + " frames");
+        if (stop_id) {
+            stop_cache_.Store(*stop_id, StopCache::Kind::FRAMES, cache_key, *frames_resp);
+        }
+        return SendArenaResponse(response);
     }
 
     bool DebuggerClient::HandleVariablesRequest(const lldbprotobuf::VariablesRequest &req,
@@ -1083,7 +1110,8 @@ if (launch_info.disable_aslr()) {
             ", in_scope_only=" + std::to_string(req.in_scope_only()) +
             ", include_runtime_support_values=" + std::to_string(req.include_runtime_support_values()) +
             ", use_dynamic=" + std::to_string(static_cast<int>(req.use_dynamic())) +
-            ", include_recognized_arguments=" + std::to_string(req.include_recognized_arguments()));
+            ", include_recognized_arguments=" + std::to_string(req.include_recognized_arguments()) +
+            ", changed_only=" + std::to_string(req.changed_only()));
 
         // 验证进程是否有效
         if (!process_.IsValid()) {
@@ -1091,20 +1119,20 @@ if (launch_info.disable_aslr()) {
             return SendVariablesResponse(false, {}, "No valid process available", hash);
         }
 
-        // 查找指定的线程
-        lldb::SBThread target_thread;
-        uint32_t num_threads = process_.GetNumThreads();
-        bool thread_found = false;
-
-        for (uint32_t i = 0; i < num_threads; ++i) {
-            lldb::SBThread sb_thread = process_.GetThreadAtIndex(i);
-            if (sb_thread.IsValid() && sb_thread.GetThreadID() == req.thread_id().id()) {
-                target_thread = sb_thread;
-                thread_found = true;
-                break;
+        const std::optional<uint32_t> stop_id = CurrentStopId();
+        const std::string cache_key = stop_id ? req.SerializeAsString() : std::string();
+        if (stop_id) {
+            lldbprotobuf::Response *cached = NewArenaResponse(hash);
+            if (stop_cache_.Lookup(*stop_id, StopCache::Kind::VARIABLES, cache_key, cached->mutable_variables())) {
+                LOG_INFO("Variables served from stop cache (stop_id=" + std::to_string(*stop_id) + ")");
+                return SendArenaResponse(cached);
             }
         }
 
+        // 查找指定的线程
+        lldb::SBThread target_thread = FindThreadById(req.thread_id().id());
+        bool thread_found = target_thread.IsValid();
+
         if (!thread_found) {
             LOG_ERROR("Thread not found: " + std::to_string(req.thread_id().id()));
             return SendVariablesResponse(false, {}, "Thread not found", hash);
@@ -1125,8 +1153,6 @@ if (launch_info.disable_aslr()) {
             return SendVariablesResponse(false, {}, "Invalid frame", hash);
         }
 
-        std::vector<lldbprotobuf::Variable> variables;
-
         // 创建变量选项对象
         lldb::SBVariablesOptions var_options;
         if (!var_options.IsValid()) {
@@ -1170,6 +1196,27 @@ if (launch_info.disable_aslr()) {
             "Found " + std::to_string(local_vars.GetSize()) + " variables in frame " + std::to_string(req.frame_index()
             ));
 
+        lldbprotobuf::Response *response = NewArenaResponse(hash);
+        lldbprotobuf::VariablesResponse *variables_resp = response->mutable_variables();
+        ProtoConverter::FillResponseStatus(variables_resp->mutable_status(), true);
+
+        // 作用域过滤所需的 PC 与当前行只计算一次；非最内层帧的 PC 是返回地址，减一后落在调用所在的块内
+        LexicalScopeCache::Visibility scope_visibility;
+        uint32_t current_line = 0;
+        lldb::SBFileSpec current_file;
+        if (req.in_scope_only()) {
+            lldb::addr_t pc = target_frame.GetPC();
+            if (req.frame_index() > 0 && pc != LLDB_INVALID_ADDRESS) {
+                --pc;
+            }
+            scope_visibility = scope_cache_.Resolve(target_frame.GetFunction(), pc, target_);
+            lldb::SBLineEntry line_entry = target_frame.GetLineEntry();
+            if (line_entry.IsValid()) {
+                current_line = line_entry.GetLine();
+                current_file = line_entry.GetFileSpec();
+            }
+        }
+
         // 转换 LLDB SBValue 到 protobuf Variable
         for (uint32_t i = 0; i < local_vars.GetSize(); ++i) {
             lldb::SBValue sb_value = local_vars.GetValueAtIndex(i);
@@ -1180,42 +1227,27 @@ if (launch_info.disable_aslr()) {
 
             // 如果请求了只显示作用域内的变量，额外检查变量是否真的在作用域内
             if (req.in_scope_only()) {
-                // 检查变量是否在当前PC位置的作用域内
-                // 方法1: 检查变量是否有错误（通常未初始化的变量会有错误）
-                lldb::SBError var_error = sb_value.GetError();
-
-                // 方法2: 获取变量的声明信息来验证作用域
                 lldb::SBDeclaration decl = sb_value.GetDeclaration();
                 if (decl.IsValid()) {
-                    // 获取当前执行位置
-                    lldb::SBLineEntry line_entry = target_frame.GetLineEntry();
-                    if (line_entry.IsValid()) {
-                        uint32_t current_line = line_entry.GetLine();
-                        uint32_t var_decl_line = decl.GetLine();
-
-                        // 检查文件是否相同
-                        lldb::SBFileSpec current_file = line_entry.GetFileSpec();
-                        lldb::SBFileSpec var_file = decl.GetFileSpec();
-
-                        bool same_file = false;
-                        if (current_file.IsValid() && var_file.IsValid()) {
-                            char current_path[1024] = {0};
-                            char var_path[1024] = {0};
-                            current_file.GetPath(current_path, sizeof(current_path));
-                            var_file.GetPath(var_path, sizeof(var_path));
-                            same_file = (std::string(current_path) == std::string(var_path));
-                        }
+                    const char *var_name = sb_value.GetName();
+                    const uint32_t var_decl_line = decl.GetLine();
+
+                    // 变量所在的词法块不覆盖当前 PC（如已退出的嵌套块）
+                    if (!scope_visibility.IsVisible(var_name, var_decl_line)) {
+                        LOG_INFO("  Skipping variable '" + std::string(var_name ? var_name : "unnamed") +
+                            "' - lexical block does not contain the current PC");
+                        continue;
+                    }
 
-                        // 如果在同一文件且当前行在变量声明行之前，跳过该变量
-                        if (same_file && current_line < var_decl_line) {
-                            const char *var_name = sb_value.GetName();
-                            LOG_INFO("  Skipping variable '" +
-                                std::string(var_name ? var_name : "unnamed") +
-                                "' - declared at line " + std::to_string(var_decl_line) +
-                                ", current line " + std::to_string(current_line) +
-                                " (not yet in scope)");
-                            continue;
-                        }
+                    // 同一块内声明在当前行之后的变量尚未初始化
+                    if (current_line != 0 && current_line < var_decl_line &&
+                        IsSameFileSpec(current_file, decl.GetFileSpec())) {
+                        LOG_INFO("  Skipping variable '" +
+                            std::string(var_name ? var_name : "unnamed") +
+                            "' - declared at line " + std::to_string(var_decl_line) +
+                            ", current line " + std::to_string(current_line) +
+                            " (not yet in scope)");
+                        continue;
                     }
                 }
             }
@@ -1224,11 +1256,23 @@ if (launch_info.disable_aslr()) {
                 // 为变量分配唯一的ID并存储映射
                 uint64_t variable_id = AllocateVariableId(req.thread_id().id(), req.frame_index(), sb_value);
 
-                // 使用 ProtoConverter 将 LLDB 变量转换为 protobuf 变量
-                lldbprotobuf::Variable proto_var = ProtoConverter::CreateVariable(sb_value, variable_id);
-
-
-                variables.push_back(proto_var);
+                // 使用 ProtoConverter 将 LLDB 变量直接填充到响应中
+                lldbprotobuf::Variable *proto_var = variables_resp->add_variables();
+                try {
+                    ProtoConverter::FillVariable(proto_var, sb_value, variable_id, &type_cache_);
+                    if (req.changed_only()) {
+                        lldbprotobuf::Value *value = proto_var->mutable_value();
+                        *value = CreateBudgetedValue(sb_value, variable_id, 1000);
+                        if (TrackValueChange(variable_id, sb_value, value) == ValueChange::UNCHANGED) {
+                            variables_resp->mutable_variables()->RemoveLast();
+                            continue;
+                        }
+                    }
+                } catch (...) {
+                    // 转换失败时移除未填充完整的条目
+                    variables_resp->mutable_variables()->RemoveLast();
+                    throw;
+                }
 
                 LOG_INFO("  Variable: " + std::string(sb_value.GetName() ? sb_value.GetName() : "unnamed") +
                     " (ID=" + std::to_string(variable_id) + ") (" +
@@ -1242,9 +1286,12 @@ if (launch_info.disable_aslr()) {
 
 
         LOG_INFO(
-            "Successfully extracted " + std::to_string(variables.size()) +
+            "Successfully extracted " + std::to_string(variables_resp->variables_size()) +
             " variables (including arguments and locals)");
-        return SendVariablesResponse(true, variables, "", hash);
+        if (stop_id) {
+            stop_cache_.Store(*stop_id, StopCache::Kind::VARIABLES, cache_key, *variables_resp);
+        }
+        return SendArenaResponse(response);
     }
 
     bool DebuggerClient::HandleRegistersRequest(const lldbprotobuf::RegistersRequest &req,
@@ -1259,20 +1306,20 @@ if (launch_info.disable_aslr()) {
             return SendRegistersResponse(false, {}, "No valid process available", hash);
         }
 
-        // 查找指定的线程
-        lldb::SBThread target_thread;
-        uint32_t num_threads = process_.GetNumThreads();
-        bool thread_found = false;
-
-        for (uint32_t i = 0; i < num_threads; ++i) {
-            lldb::SBThread sb_thread = process_.GetThreadAtIndex(i);
-            if (sb_thread.IsValid() && sb_thread.GetThreadID() == req.thread_id().id()) {
-                target_thread = sb_thread;
-                thread_found = true;
-                break;
+        const std::optional<uint32_t> stop_id = CurrentStopId();
+        const std::string cache_key = stop_id ? req.SerializeAsString() : std::string();
+        if (stop_id) {
+            lldbprotobuf::Response *cached = NewArenaResponse(hash);
+            if (stop_cache_.Lookup(*stop_id, StopCache::Kind::REGISTERS, cache_key, cached->mutable_registers())) {
+                LOG_INFO("Registers served from stop cache (stop_id=" + std::to_string(*stop_id) + ")");
+                return SendArenaResponse(cached);
             }
         }
 
+        // 查找指定的线程
+        lldb::SBThread target_thread = FindThreadById(req.thread_id().id());
+        bool thread_found = target_thread.IsValid();
+
         if (!thread_found) {
             LOG_ERROR("Thread not found: " + std::to_string(req.thread_id().id()));
             return SendRegistersResponse(false, {}, "Thread not found", hash);
@@ -1300,7 +1347,9 @@ if (launch_info.disable_aslr()) {
             return SendRegistersResponse(false, {}, "Failed to get register context", hash);
         }
 
-        std::vector<lldbprotobuf::Register> registers;
+        lldbprotobuf::Response *response = NewArenaResponse(hash);
+        lldbprotobuf::RegistersResponse *registers_resp = response->mutable_registers();
+        ProtoConverter::FillResponseStatus(registers_resp->mutable_status(), true);
 
         LOG_INFO(
             "Found " + std::to_string(reg_vars.GetSize()) + " registers in frame " + std::to_string(req.frame_index()));
@@ -1367,7 +1416,7 @@ if (launch_info.disable_aslr()) {
                     }
                 }
 
-                registers.push_back(proto_register);
+                *registers_resp->add_registers() = std::move(proto_register);
 
                 LOG_INFO("  Register: " + std::string(reg_name) +
                     " (group: " + register_group + ") = " +
@@ -1378,8 +1427,11 @@ if (launch_info.disable_aslr()) {
             }
         }
 
-        LOG_INFO("Successfully extracted " + std::to_string(registers.size()) + " registers");
-        return SendRegistersResponse(true, registers, "", hash);
+        LOG_INFO("Successfully extracted " + std::to_string(registers_resp->registers_size()) + " registers");
+        if (stop_id) {
+            stop_cache_.Store(*stop_id, StopCache::Kind::REGISTERS, cache_key, *registers_resp);
+        }
+        return SendArenaResponse(response);
     }
 
     bool DebuggerClient::HandleRegisterGroupsRequest(const lldbprotobuf::RegisterGroupsRequest &req,
@@ -1396,16 +1448,7 @@ if (launch_info.disable_aslr()) {
 
         // 如果指定了线程ID，验证线程是否存在
         if (req.has_thread_id()) {
-            bool thread_found = false;
-            uint32_t num_threads = process_.GetNumThreads();
-
-            for (uint32_t i = 0; i < num_threads; ++i) {
-                lldb::SBThread sb_thread = process_.GetThreadAtIndex(i);
-                if (sb_thread.IsValid() && sb_thread.GetThreadID() == req.thread_id().id()) {
-                    thread_found = true;
-                    break;
-                }
-            }
+            bool thread_found = FindThreadById(req.thread_id().id()).IsValid();
 
             if (!thread_found) {
                 LOG_ERROR("Thread not found: " + std::to_string(req.thread_id().id()));
@@ -1474,13 +1517,16 @@ if (launch_info.disable_aslr()) {
 
         try {
             // 创建变量信息
-            lldbprotobuf::Variable variable = ProtoConverter::CreateVariable(sb_value, req.variable_id().id());
+            lldbprotobuf::Variable variable = ProtoConverter::CreateVariable(sb_value, req.variable_id().id(), &type_cache_);
 
             // 创建值信息
-            lldbprotobuf::Value value = ProtoConverter::CreateValue(
+            lldbprotobuf::Value value = CreateBudgetedValue(
                 sb_value,
                 req.variable_id().id(),
-                req.max_string_length());
+                req.max_string_length(),
+                req.defer_summary());
+            // SBValue 每次停止都会重建，GetValueDidChange() 总是 false，改为按指纹跨停止比较
+            TrackValueChange(req.variable_id().id(), sb_value, &value);
 
             LOG_INFO("Successfully created value for variable: " + variable.name() +
                 " (type: " + variable.type().type_name() + ")");
@@ -1496,11 +1542,60 @@ if (launch_info.disable_aslr()) {
         }
     }
 
+    bool DebuggerClient::HandleGetSummariesRequest(const lldbprotobuf::GetSummariesRequest &req,
+                                                   const std::optional<uint64_t> hash) const {
+        constexpr uint32_t DEFAULT_MAX_STRING_LENGTH = 1000;
+        const uint32_t max_string_length = req.max_string_length() > 0 ? req.max_string_length()
+                                                                        : DEFAULT_MAX_STRING_LENGTH;
+        LOG_INFO("Handling GetSummaries request: variables=" + std::to_string(req.variable_ids_size()) +
+            ", max_string_length=" + std::to_string(max_string_length));
+
+        lldbprotobuf::Response *response = NewArenaResponse(hash);
+        lldbprotobuf::GetSummariesResponse *summaries_resp = response->mutable_get_summaries();
+
+        if (!process_.IsValid()) {
+            LOG_ERROR("No valid process available");
+            ProtoConverter::FillResponseStatus(summaries_resp->mutable_status(), false, "No valid process available");
+            return SendArenaResponse(response);
+        }
+
+        int deferred = 0;
+        for (const auto &variable_id: req.variable_ids()) {
+            lldbprotobuf::Value *value = summaries_resp->add_values();
+            lldb::SBValue sb_value = FindVariableById(variable_id.id());
+            if (!sb_value.IsValid()) {
+                value->mutable_variable_id()->set_id(variable_id.id());
+                value->set_error("Variable not found or invalid");
+                continue;
+            }
+
+            try {
+                *value = CreateBudgetedValue(sb_value, variable_id.id(), max_string_length);
+                TrackValueChange(variable_id.id(), sb_value, value);
+                if (value->summary_deferred()) {
+                    ++deferred;
+                }
+            } catch (const std::exception &e) {
+                value->Clear();
+                value->mutable_variable_id()->set_id(variable_id.id());
+                value->set_error(e.what());
+            }
+        }
+
+        ProtoConverter::FillResponseStatus(summaries_resp->mutable_status(), true);
+        LOG_INFO("GetSummaries completed: " + std::to_string(summaries_resp->values_size() - deferred) +
+            " computed, " + std::to_string(deferred) + " still deferred");
+        return SendArenaResponse(response);
+    }
+
     bool DebuggerClient::HandleSetVariableValueRequest(const lldbprotobuf::SetVariableValueRequest &req,
                                                        const std::optional<uint64_t> hash) const {
         LOG_INFO("Handling SetVariableValue request: variable_id=" + std::to_string(req.variable_id().id()) +
             ", value=" + req.value());
 
+        // 修改变量会改变已缓存的变量值和寄存器
+        stop_cache_.InvalidateValues();
+
         // 验证进程是否有效
         if (!process_.IsValid()) {
             LOG_ERROR("No valid process available");
@@ -1544,13 +1639,14 @@ if (launch_info.disable_aslr()) {
 
             // 创建变量信息
             lldbprotobuf::Variable variable = ProtoConverter::CreateVariable(sb_value,
-                                                                             req.variable_id().id());
+                                                                             req.variable_id().id(), &type_cache_);
 
             // 创建值信息
-            lldbprotobuf::Value value = ProtoConverter::CreateValue(
+            lldbprotobuf::Value value = CreateBudgetedValue(
                 sb_value,
                 req.variable_id().id(),
                 1024); // 使用合理的默认字符串长度
+            TrackValueChange(req.variable_id().id(), sb_value, &value);
 
             LOG_INFO("Successfully set value for variable: " + variable.name() +
                 " (type: " + variable.type().type_name() + ") to: " + req.value());
@@ -1610,42 +1706,26 @@ if (launch_info.disable_aslr()) {
             }
         }
 
-        std::vector<lldbprotobuf::Variable> children;
-        uint32_t total_children = parent_value.GetNumChildren();
-
-        // 计算请求的范围
-        uint32_t start_idx = std::min(req.offset(), total_children);
-        uint32_t end_idx = std::min(start_idx + req.count(), total_children);
-        bool has_more = (end_idx < total_children);
+        lldbprotobuf::Response *response = NewArenaResponse(hash);
+        lldbprotobuf::VariablesChildrenResponse *children_resp = response->mutable_get_variables_children();
+        ProtoConverter::FillResponseStatus(children_resp->mutable_status(), true);
 
-        LOG_INFO("Variable has " + std::to_string(total_children) + " children, returning " +
-            std::to_string(end_idx - start_idx) + " from index " + std::to_string(start_idx) +
-            " (thread_id=" + std::to_string(thread_id) + ", frame_index=" + std::to_string(frame_index) + ")");
+        const uint32_t total_children = FillChildWindow(parent_value, req.offset(), req.count(), thread_id,
+                                                        frame_index, children_resp->mutable_children());
+        const uint32_t start_idx = std::min(req.offset(), total_children);
+        const uint32_t end_idx = start_idx + std::min(req.count(), total_children - start_idx);
+        children_resp->set_total_children(total_children);
+        children_resp->set_offset(start_idx);
+        children_resp->set_has_more(end_idx < total_children);
 
-        // 获取指定范围的子变量
-        for (uint32_t i = start_idx; i < end_idx; ++i) {
-            lldb::SBValue child_value = parent_value.GetChildAtIndex(i);
-            if (!child_value.IsValid()) {
-                continue;
-            }
-
-            try {
-                uint64_t child_id = AllocateVariableId(thread_id, frame_index, child_value);
-
-                // 创建子变量信息
-                lldbprotobuf::Variable child_variable = ProtoConverter::CreateVariable(child_value, child_id);
-                children.push_back(child_variable);
-
-                LOG_INFO("  Child: " + std::string(child_value.GetName() ? child_value.GetName() : "unnamed") +
-                    " (" + std::string(child_value.GetTypeName() ? child_value.GetTypeName() : "unknown") + ")");
-            } catch (const std::exception &e) {
-                LOG_WARNING("Failed to convert child variable at index " + std::to_string(i) + ": " + e.what());
-                // 继续处理其他子变量，不要因为一个失败而中断
-            }
+        // 深度展开：子变量在同一响应中内联到 max_depth 层
+        if (req.max_depth() > 1) {
+            ExpandChildSubtrees(children_resp->mutable_children(), req.max_depth(), req.max_children(), thread_id,
+                                frame_index);
         }
 
-        LOG_INFO("Successfully retrieved " + std::to_string(children.size()) + " child variables");
-        return SendVariablesChildrenResponse(true, children, total_children, start_idx, has_more, "", hash);
+        LOG_INFO("Successfully retrieved " + std::to_string(children_resp->children_size()) + " child variables");
+        return SendArenaResponse(response);
     }
 
     bool DebuggerClient::HandleEvaluateRequest(const lldbprotobuf::EvaluateRequest &req,
@@ -1653,116 +1733,30 @@ if (launch_info.disable_aslr()) {
         LOG_INFO("Handling Evaluate request: expression='" + req.expression() + "'" +
             ", thread_id=" + std::to_string(req.thread_id().id()) +
             ", frame_index=" + std::to_string(req.frame_index()) +
-            ", disable_summaries=" + std::to_string(req.disable_summaries()));
-
-        // 验证进程是否有效
-        if (!process_.IsValid()) {
-            LOG_ERROR("No valid process available for expression evaluation");
-            lldbprotobuf::Variable empty_value;
-            return SendEvaluateResponse(false, empty_value, "No valid process available", hash);
-        }
+            ", disable_summaries=" + std::to_string(req.disable_summaries()) +
+            ", timeout_ms=" + std::to_string(req.timeout_ms()) +
+            ", thread_policy=" + std::to_string(static_cast<int>(req.thread_policy())) +
+            ", no_jit=" + std::to_string(req.no_jit()));
 
-        // 查找指定的线程
         lldb::SBThread target_thread;
-        if (req.has_thread_id()) {
-            uint32_t num_threads = process_.GetNumThreads();
-            bool thread_found = false;
-
-            for (uint32_t i = 0; i < num_threads; ++i) {
-                lldb::SBThread sb_thread = process_.GetThreadAtIndex(i);
-                if (sb_thread.IsValid() && sb_thread.GetThreadID() == req.thread_id().id()) {
-                    target_thread = sb_thread;
-                    thread_found = true;
-                    break;
-                }
-            }
-
-            if (!thread_found) {
-                LOG_ERROR("Thread not found for expression evaluation: " + std::to_string(req.thread_id().id()));
-                lldbprotobuf::Variable empty_value;
-                return SendEvaluateResponse(false, empty_value, "Thread not found", hash);
-            }
-        } else {
-            // 如果没有指定线程，使用当前选中的线程
-            target_thread = process_.GetSelectedThread();
-            if (!target_thread.IsValid()) {
-                LOG_ERROR("No selected thread available for expression evaluation");
-                lldbprotobuf::Variable empty_value;
-                return SendEvaluateResponse(false, empty_value, "No selected thread available", hash);
-            }
-        }
-
-        // 获取栈帧
         lldb::SBFrame target_frame;
-        // frame_index is optional in protobuf, check if it's set to a non-default value
-        if (req.frame_index() != 0) {
-            uint32_t num_frames = target_thread.GetNumFrames();
-            if (req.frame_index() >= num_frames) {
-                LOG_ERROR(
-                    "Frame index out of range: " + std::to_string(req.frame_index()) + " >= " + std::to_string(
-                        num_frames));
-                lldbprotobuf::Variable empty_value;
-                return SendEvaluateResponse(false, empty_value, "Frame index out of range", hash);
-            }
-
-            target_frame = target_thread.GetFrameAtIndex(req.frame_index());
-        } else {
-            // 如果没有指定帧，使用当前帧（栈顶）
-            target_frame = target_thread.GetFrameAtIndex(0);
-        }
-
-        if (!target_frame.IsValid()) {
-            LOG_ERROR("Invalid frame for expression evaluation");
+        std::string error_message;
+        if (!ResolveEvaluationFrame(req.has_thread_id(), req.thread_id().id(), req.frame_index(), target_thread,
+                                    target_frame, error_message)) {
+            LOG_ERROR("Cannot evaluate expression: " + error_message);
             lldbprotobuf::Variable empty_value;
-            return SendEvaluateResponse(false, empty_value, "Invalid frame", hash);
+            return SendEvaluateResponse(false, empty_value, error_message, hash);
         }
 
-        try {
-            // 配置表达式求值选项
-            lldb::SBExpressionOptions options;
+        lldbprotobuf::Response *response = NewArenaResponse(hash);
+        lldbprotobuf::EvaluateResponse *evaluate_resp = response->mutable_evaluate();
+        EvaluateInFrame(target_thread, target_frame, req.expression(), req, evaluate_resp);
 
-            // 根据请求配置选项
-            if (req.disable_summaries()) {
-                // 禁用摘要提供者，获取原始值
-                // TODO: 设置相应选项
-            }
-
-            // 执行表达式求值
-            lldb::SBError error;
-            lldb::SBValue result = target_frame.EvaluateExpression(req.expression().c_str(), options);
-            uint64_t variable_id = AllocateVariableId(
-                target_thread.GetThreadID(),
-                target_frame.GetFrameID(),
-                result);
-            lldbprotobuf::Variable variable = ProtoConverter::CreateVariable(result, variable_id);
-            if (error.Fail()) {
-                std::string error_msg = error.GetCString() ? error.GetCString() : "Expression evaluation failed";
-                LOG_ERROR("Expression evaluation failed: " + error_msg);
-                lldbprotobuf::Variable empty_value;
-                return SendEvaluateResponse(false, empty_value, "Expression evaluation failed: " + error_msg, hash);
-            }
-
-            if (!result.IsValid()) {
-                LOG_ERROR("Expression evaluation returned invalid result");
-                lldbprotobuf::Variable empty_value;
-                return SendEvaluateResponse(false, empty_value, "Expression evaluation returned invalid result", hash);
-            }
-
-
-            LOG_INFO("Expression evaluated successfully: '" + req.expression() + "' = " +
-                (result.GetValue() ? std::string(result.GetValue()) : "<no value>"));
-
-            return SendEvaluateResponse(true, variable, "", hash);
-        } catch (const std::exception &e) {
-            LOG_ERROR("Exception during expression evaluation: " + std::string(e.what()));
-            lldbprotobuf::Variable empty_value;
-            return SendEvaluateResponse(false, empty_value,
-                                        "Exception during expression evaluation: " + std::string(e.what()), hash);
-        } catch (...) {
-            LOG_ERROR("Unknown exception during expression evaluation");
-            lldbprotobuf::Variable empty_value;
-            return SendEvaluateResponse(false, empty_value, "Unknown exception during expression evaluation", hash);
+        // 经过表达式引擎的求值可能有副作用（赋值、函数调用），即使失败也可能已部分执行
+        if (evaluate_resp->evaluation_path() != lldbprotobuf::EVALUATION_PATH_VARIABLE_PATH) {
+            stop_cache_.InvalidateValues();
         }
+        return SendArenaResponse(response);
     }
 
     bool DebuggerClient::HandleReadMemoryRequest(const lldbprotobuf::ReadMemoryRequest &req,
@@ -1829,6 +1823,8 @@ if (launch_info.disable_aslr()) {
         LOG_INFO("Handling WriteMemory request: address=0x" + std::to_string(req.address()) +
             ", data_size=" + std::to_string(req.data().size()));
 
+        stop_cache_.InvalidateValues();
+
         // 验证进程是否有效
         if (!process_.IsValid()) {
             LOG_ERROR("No valid process available for memory writing");
@@ -2014,8 +2010,10 @@ if (launch_info.disable_aslr()) {
                 return SendDisassembleResponse(false, {}, 0, false, 0, "Failed to get instruction list", hash);
             }
 
-            // 转换为protobuf格式
-            std::vector<lldbprotobuf::DisassembleInstruction> instructions;
+            // 转换为protobuf格式，指令直接追加到 arena 上的响应中
+            lldbprotobuf::Response *response = NewArenaResponse(hash);
+            lldbprotobuf::DisassembleResponse *disassemble_resp = response->mutable_disassemble();
+            ProtoConverter::FillResponseStatus(disassemble_resp->mutable_status(), true);
             uint32_t instruction_count = instruction_list.GetSize();
             uint32_t bytes_disassembled = 0;
 
@@ -2047,7 +2045,7 @@ if (launch_info.disable_aslr()) {
                     continue;
                 }
 
-                lldbprotobuf::DisassembleInstruction proto_instruction;
+                lldbprotobuf::DisassembleInstruction &proto_instruction = *disassemble_resp->add_instructions();
 
                 // 设置地址
                 proto_instruction.set_address(inst_address);
@@ -2108,21 +2106,21 @@ if (launch_info.disable_aslr()) {
                         char file_path[1024];
                         file_spec.GetPath(file_path, sizeof(file_path));
 
-                        lldbprotobuf::SourceLocation source_location;
-                        source_location.set_file_path(file_path);
-                        source_location.set_line(line_entry.GetLine());
-
-                        *proto_instruction.mutable_source_location() = source_location;
+                        lldbprotobuf::SourceLocation *source_location = proto_instruction.mutable_source_location();
+                        source_location->set_file_path(file_path);
+                        source_location->set_line(line_entry.GetLine());
                     }
                 }
-
-                instructions.push_back(std::move(proto_instruction));
             }
 
-            LOG_INFO("Successfully disassembled " + std::to_string(instructions.size()) +
+            disassemble_resp->set_bytes_disassembled(bytes_disassembled);
+            disassemble_resp->set_alignment_verified(false);
+            disassemble_resp->set_actual_end_address(0);
+
+            LOG_INFO("Successfully disassembled " + std::to_string(disassemble_resp->instructions_size()) +
                 " instructions, " + std::to_string(bytes_disassembled) + " bytes");
 
-            return SendDisassembleResponse(true, instructions, bytes_disassembled, false, 0, "", hash);
+            return SendArenaResponse(response);
         } catch (const std::exception &e) {
             LOG_ERROR("Exception during disassembly: " + std::string(e.what()));
             return SendDisassembleResponse(false, {}, 0, false, 0,
@@ -2295,6 +2293,9 @@ if (launch_info.disable_aslr()) {
             ", echo_command=" + std::to_string(req.echo_command()) +
             ", async_execution=" + std::to_string(req.async_execution()));
 
+        // 任意 LLDB 命令都可能改变线程、栈帧或变量状态
+        stop_cache_.Invalidate();
+
         // 验证 LLDB 是否已初始化
         if (!InitializeLLDB()) {
             LOG_ERROR("Failed to initialize LLDB for command execution");
@@ -2314,18 +2315,8 @@ if (launch_info.disable_aslr()) {
         // 可选：设置执行上下文（线程和栈帧）
         if (req.has_thread_id() && process_.IsValid()) {
             // 查找指定的线程
-            lldb::SBThread target_thread;
-            uint32_t num_threads = process_.GetNumThreads();
-            bool thread_found = false;
-
-            for (uint32_t i = 0; i < num_threads; ++i) {
-                lldb::SBThread sb_thread = process_.GetThreadAtIndex(i);
-                if (sb_thread.IsValid() && sb_thread.GetThreadID() == req.thread_id().id()) {
-                    target_thread = sb_thread;
-                    thread_found = true;
-                    break;
-                }
-            }
+            lldb::SBThread target_thread = FindThreadById(req.thread_id().id());
+            bool thread_found = target_thread.IsValid();
 
             if (thread_found) {
                 // 设置选中的线程
@@ -26,7 +26,176 @@
 #include "cangjie/debugger/ProtoConverter.h"
 #include "cangjie/debugger/Logger.h"
 
+#include <memory>
+#include <utility>
+
 namespace Cangjie::Debugger {
+    namespace {
+        // 响应 arena 的初始内存块大小，重置时保留该块，常规请求无需再向系统申请内存
+        constexpr size_t RESPONSE_ARENA_INITIAL_BLOCK_SIZE = 256 * 1024;
+
+        /**
+         * @brief 在单个响应内执行字符串驻留，新分配的定义追加到该响应的 interned_strings
+         */
+        class StringInterner {
+        public:
+            StringInterner(StringInternTable &table,
+                           google::protobuf::RepeatedPtrField<lldbprotobuf::InternedString> *definitions)
+                : table_(table), definitions_(definitions) {
+            }
+
+            /**
+             * @return 驻留 Id；字符串不参与驻留时返回 0，调用方保留原文
+             */
+            uint32_t Intern(const std::string &value) {
+                bool is_new = false;
+                const uint32_t id = table_.Intern(value, &is_new);
+                if (is_new) {
+                    lldbprotobuf::InternedString *definition = definitions_->Add();
+                    definition->set_id(id);
+                    definition->set_value(value);
+                }
+                return id;
+            }
+
+            void InternType(lldbprotobuf::Type *type) {
+                if (const uint32_t ref = Intern(type->type_name())) {
+                    type->set_type_name_ref(ref);
+                    type->clear_type_name();
+                }
+                if (const uint32_t ref = Intern(type->display_type())) {
+                    type->set_display_type_ref(ref);
+                    type->clear_display_type();
+                }
+            }
+
+            /**
+             * @brief 驻留变量及其内联展开的子变量的类型名
+             */
+            void InternVariable(lldbprotobuf::Variable *variable) {
+                InternType(variable->mutable_type());
+                for (auto &child: *variable->mutable_children()) {
+                    InternVariable(&child);
+                }
+            }
+
+            void InternLocation(lldbprotobuf::SourceLocation *location) {
+                if (const uint32_t ref = Intern(location->file_path())) {
+                    location->set_file_path_ref(ref);
+                    location->clear_file_path();
+                }
+            }
+
+        private:
+            StringInternTable &table_;
+            google::protobuf::RepeatedPtrField<lldbprotobuf::InternedString> *definitions_;
+        };
+    }
+
+    // ============================================================================
+    // Arena Response
+    // ============================================================================
+
+    lldbprotobuf::Response *DebuggerClient::NewArenaResponse(const std::optional<uint64_t> hash) const {
+        if (!response_arena_) {
+            response_arena_block_.resize(RESPONSE_ARENA_INITIAL_BLOCK_SIZE);
+            google::protobuf::ArenaOptions options;
+            options.initial_block = response_arena_block_.data();
+            options.initial_block_size = response_arena_block_.size();
+            response_arena_ = std::make_unique<google::protobuf::Arena>(options);
+        }
+
+        auto *response = google::protobuf::Arena::CreateMessage<lldbprotobuf::Response>(response_arena_.get());
+        if (hash.has_value()) {
+            response->mutable_hash()->set_hash(hash.value());
+        }
+        return response;
+    }
+
+    bool DebuggerClient::SendArenaResponse(lldbprotobuf::Response *response) const {
+        LOG_INFO("Sending arena response: case=" + std::to_string(static_cast<int>(response->response_case())));
+        return DeliverResponse(*response);
+    }
+
+    bool DebuggerClient::DeliverResponse(lldbprotobuf::Response &response) const {
+        if (string_intern_enabled_) {
+            InternResponseStrings(response);
+        }
+        if (batch_sink_ != nullptr) {
+            // 同一 arena 上的移动赋值只交换指针；栈上响应会被拷贝到 arena 中
+            *batch_sink_->add_responses() = std::move(response);
+            return true;
+        }
+        return tcp_client_.SendProtoMessage(response);
+    }
+
+    void DebuggerClient::InternResponseStrings(lldbprotobuf::Response &response) const {
+        switch (response.response_case()) {
+            case lldbprotobuf::Response::kVariables: {
+                lldbprotobuf::VariablesResponse *variables = response.mutable_variables();
+                StringInterner interner(string_intern_, variables->mutable_interned_strings());
+                for (auto &variable: *variables->mutable_variables()) {
+                    interner.InternType(variable.mutable_type());
+                }
+                break;
+            }
+            case lldbprotobuf::Response::kGetVariablesChildren: {
+                lldbprotobuf::VariablesChildrenResponse *children = response.mutable_get_variables_children();
+                StringInterner interner(string_intern_, children->mutable_interned_strings());
+                for (auto &child: *children->mutable_children()) {
+                    interner.InternVariable(&child);
+                }
+                break;
+            }
+            case lldbprotobuf::Response::kEvaluateExpressions: {
+                lldbprotobuf::EvaluateExpressionsResponse *expressions = response.mutable_evaluate_expressions();
+                StringInterner interner(string_intern_, expressions->mutable_interned_strings());
+                for (auto &result: *expressions->mutable_results()) {
+                    if (result.has_result()) {
+                        interner.InternVariable(result.mutable_result());
+                    }
+                }
+                break;
+            }
+            case lldbprotobuf::Response::kFrames: {
+                lldbprotobuf::FramesResponse *frames = response.mutable_frames();
+                StringInterner interner(string_intern_, frames->mutable_interned_strings());
+                for (auto &frame: *frames->mutable_frames()) {
+                    if (const uint32_t ref = interner.Intern(frame.module())) {
+                        frame.set_module_ref(ref);
+                        frame.clear_module();
+                    }
+                    if (frame.has_location()) {
+                        interner.InternLocation(frame.mutable_location());
+                    }
+                }
+                break;
+            }
+            case lldbprotobuf::Response::kDisassemble: {
+                lldbprotobuf::DisassembleResponse *disassemble = response.mutable_disassemble();
+                StringInterner interner(string_intern_, disassemble->mutable_interned_strings());
+                for (auto &instruction: *disassemble->mutable_instructions()) {
+                    if (const uint32_t ref = interner.Intern(instruction.symbol())) {
+                        instruction.set_symbol_ref(ref);
+                        instruction.clear_symbol();
+                    }
+                    if (instruction.has_source_location()) {
+                        interner.InternLocation(instruction.mutable_source_location());
+                    }
+                }
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+    void DebuggerClient::ResetResponseArena() const {
+        if (response_arena_) {
+            response_arena_->Reset();
+        }
+    }
+
 
     bool DebuggerClient::SendCreateTargetResponse(
         bool success,
@@ -43,10 +212,10 @@ namespace Cangjie::Debugger {
             *response.mutable_hash() = CreateHashId(hash.value());
         }
 
-        *response.mutable_create_target() = create_target_resp;
+        *response.mutable_create_target() = std::move(create_target_resp);
 
         LOG_INFO("Sending CreateTarget response: success=" + std::to_string(success));
-        return tcp_client_.SendProtoMessage(response);
+        return DeliverResponse(response);
     }
 
     bool DebuggerClient::SendLaunchResponse(
@@ -64,11 +233,11 @@ namespace Cangjie::Debugger {
         if (hash.has_value()) {
             *response.mutable_hash() = CreateHashId(hash.value());
         }
-        *response.mutable_launch() = launch_resp;
+        *response.mutable_launch() = std::move(launch_resp);
 
         LOG_INFO("Sending Launch response: success=" + std::to_string(success) +
             ", process_id=" + std::to_string(process_id));
-        return tcp_client_.SendProtoMessage(response);
+        return DeliverResponse(response);
     }
 
     bool DebuggerClient::SendContinueResponse(const std::optional<uint64_t> hash) const {
@@ -82,10 +251,10 @@ namespace Cangjie::Debugger {
             *response.mutable_hash() = CreateHashId(hash.value());
         }
 
-        *response.mutable_continue_() = continue_resp;
+        *response.mutable_continue_() = std::move(continue_resp);
 
         LOG_INFO("Sending Continue response");
-        return tcp_client_.SendProtoMessage(response);
+        return DeliverResponse(response);
     }
 
     bool DebuggerClient::SendSuspendResponse(const std::optional<uint64_t> hash) const {
@@ -98,10 +267,10 @@ namespace Cangjie::Debugger {
         if (hash.has_value()) {
             *response.mutable_hash() = CreateHashId(hash.value());
         }
-        *response.mutable_suspend() = suspend_resp;
+        *response.mutable_suspend() = std::move(suspend_resp);
 
         LOG_INFO("Sending Suspend response");
-        return tcp_client_.SendProtoMessage(response);
+        return DeliverResponse(response);
     }
 
     bool DebuggerClient::SendDetachResponse(bool success, const std::string &error_message,
@@ -113,10 +282,10 @@ namespace Cangjie::Debugger {
             *response.mutable_hash() = CreateHashId(hash.value());
         }
 
-        *response.mutable_detach() = detach_resp;
+        *response.mutable_detach() = std::move(detach_resp);
 
         LOG_INFO("Sending Detach response");
-        return tcp_client_.SendProtoMessage(response);
+        return DeliverResponse(response);
     }
 
     bool DebuggerClient::SendTerminateResponse(const std::optional<uint64_t> hash) const {
@@ -127,10 +296,10 @@ namespace Cangjie::Debugger {
             *response.mutable_hash() = CreateHashId(hash.value());
         }
 
-        *response.mutable_kill() = kill_resp;
+        *response.mutable_kill() = std::move(kill_resp);
 
         LOG_INFO("Sending Kill response");
-        return tcp_client_.SendProtoMessage(response);
+        return DeliverResponse(response);
     }
 
     bool DebuggerClient::SendExitResponse(const std::optional<uint64_t> hash) const {
@@ -141,10 +310,10 @@ namespace Cangjie::Debugger {
             *response.mutable_hash() = CreateHashId(hash.value());
         }
 
-        *response.mutable_exit() = exit_resp;
+        *response.mutable_exit() = std::move(exit_resp);
 
         LOG_INFO("Sending Exit response");
-        return tcp_client_.SendProtoMessage(response);
+        return DeliverResponse(response);
     }
 
     bool DebuggerClient::SendStepIntoResponse(bool success, const std::string &error_message,
@@ -155,10 +324,10 @@ namespace Cangjie::Debugger {
         if (hash.has_value()) {
             *response.mutable_hash() = CreateHashId(hash.value());
         }
-        *response.mutable_step_into() = step_into_resp;
+        *response.mutable_step_into() = std::move(step_into_resp);
 
         LOG_INFO("Sending StepInto response: success=" + std::to_string(success));
-        return tcp_client_.SendProtoMessage(response);
+        return DeliverResponse(response);
     }
 
     bool DebuggerClient::SendStepOverResponse(bool success, const std::string &error_message,
@@ -170,10 +339,10 @@ namespace Cangjie::Debugger {
             *response.mutable_hash() = CreateHashId(hash.value());
         }
 
-        *response.mutable_step_over() = step_over_resp;
+        *response.mutable_step_over() = std::move(step_over_resp);
 
         LOG_INFO("Sending StepOver response: success=" + std::to_string(success));
-        return tcp_client_.SendProtoMessage(response);
+        return DeliverResponse(response);
     }
 
     bool DebuggerClient::SendStepOutResponse(bool success, const std::string &error_message,
@@ -185,10 +354,10 @@ namespace Cangjie::Debugger {
             *response.mutable_hash() = CreateHashId(hash.value());
         }
 
-        *response.mutable_step_out() = step_out_resp;
+        *response.mutable_step_out() = std::move(step_out_resp);
 
         LOG_INFO("Sending StepOut response: success=" + std::to_string(success));
-        return tcp_client_.SendProtoMessage(response);
+        return DeliverResponse(response);
     }
 
     bool DebuggerClient::SendRunToCursorResponse(bool success, uint64_t temp_breakpoint_id,
@@ -203,11 +372,11 @@ namespace Cangjie::Debugger {
             *response.mutable_hash() = CreateHashId(hash.value());
         }
 
-        *response.mutable_run_to_cursor() = run_to_cursor_resp;
+        *response.mutable_run_to_cursor() = std::move(run_to_cursor_resp);
 
         LOG_INFO("Sending RunToCursor response: success=" + std::to_string(success) +
                  ", method=" + method_used);
-        return tcp_client_.SendProtoMessage(response);
+        return DeliverResponse(response);
     }
 
     bool DebuggerClient::SendAttachResponse(bool success, const std::string &error_message,
@@ -218,10 +387,10 @@ namespace Cangjie::Debugger {
         if (hash.has_value()) {
             *response.mutable_hash() = CreateHashId(hash.value());
         }
-        *response.mutable_attach() = attach_resp;
+        *response.mutable_attach() = std::move(attach_resp);
 
         LOG_INFO("Sending Attach response: success=" + std::to_string(success));
-        return tcp_client_.SendProtoMessage(response);
+        return DeliverResponse(response);
     }
 
     bool DebuggerClient::SendThreadsResponse(bool success, const std::vector<lldbprotobuf::Thread> &threads,
@@ -233,12 +402,12 @@ namespace Cangjie::Debugger {
         if (hash.has_value()) {
             *response.mutable_hash() = CreateHashId(hash.value());
         }
-        *response.mutable_threads() = threads_resp;
+        *response.mutable_threads() = std::move(threads_resp);
 
         LOG_INFO(
             "Sending Threads response: success=" + std::to_string(success) + ", thread_count=" + std::to_string(threads.
                 size()));
-        return tcp_client_.SendProtoMessage(response);
+        return DeliverResponse(response);
     }
 
     bool DebuggerClient::SendFramesResponse(bool success, const std::vector<lldbprotobuf::Frame> &frames,
@@ -250,12 +419,12 @@ namespace Cangjie::Debugger {
         if (hash.has_value()) {
             *response.mutable_hash() = CreateHashId(hash.value());
         }
-        *response.mutable_frames() = frames_resp;
+        *response.mutable_frames() = std::move(frames_resp);
 
         LOG_INFO(
             "Sending Frames response: success=" + std::to_string(success) + ", frame_count=" + std::to_string(frames.
                 size()) + ", total_frames=" + std::to_string(total_frames));
-        return tcp_client_.SendProtoMessage(response);
+        return DeliverResponse(response);
     }
 
     bool DebuggerClient::SendVariablesResponse(bool success, const std::vector<lldbprotobuf::Variable> &variables,
@@ -267,12 +436,12 @@ namespace Cangjie::Debugger {
         if (hash.has_value()) {
             *response.mutable_hash() = CreateHashId(hash.value());
         }
-        *response.mutable_variables() = variables_resp;
+        *response.mutable_variables() = std::move(variables_resp);
 
         LOG_INFO(
             "Sending Variables response: success=" + std::to_string(success) + ", variable_count=" + std::to_string(
                 variables.size()));
-        return tcp_client_.SendProtoMessage(response);
+        return DeliverResponse(response);
     }
 
     bool DebuggerClient::SendGetValueResponse(bool success, const lldbprotobuf::Value &value,
@@ -285,10 +454,10 @@ namespace Cangjie::Debugger {
         if (hash.has_value()) {
             *response.mutable_hash() = CreateHashId(hash.value());
         }
-        *response.mutable_get_value() = get_value_resp;
+        *response.mutable_get_value() = std::move(get_value_resp);
 
         LOG_INFO("Sending GetValue response: success=" + std::to_string(success));
-        return tcp_client_.SendProtoMessage(response);
+        return DeliverResponse(response);
     }
 
     bool DebuggerClient::SendSetVariableValueResponse(bool success, const lldbprotobuf::Value &value,
@@ -301,10 +470,10 @@ namespace Cangjie::Debugger {
         if (hash.has_value()) {
             *response.mutable_hash() = CreateHashId(hash.value());
         }
-        *response.mutable_set_variable_value() = set_value_resp;
+        *response.mutable_set_variable_value() = std::move(set_value_resp);
 
         LOG_INFO("Sending SetVariableValue response: success=" + std::to_string(success));
-        return tcp_client_.SendProtoMessage(response);
+        return DeliverResponse(response);
     }
 
     bool DebuggerClient::SendVariablesChildrenResponse(bool success,
@@ -319,12 +488,12 @@ namespace Cangjie::Debugger {
         if (hash.has_value()) {
             *response.mutable_hash() = CreateHashId(hash.value());
         }
-        *response.mutable_get_variables_children() = children_resp;
+        *response.mutable_get_variables_children() = std::move(children_resp);
 
         LOG_INFO(
             "Sending VariablesChildren response: success=" + std::to_string(success) + ", children_count=" + std::
             to_string(children.size()));
-        return tcp_client_.SendProtoMessage(response);
+        return DeliverResponse(response);
     }
 
     bool DebuggerClient::SendAddBreakpointResponse(
@@ -341,12 +510,12 @@ namespace Cangjie::Debugger {
         if (hash.has_value()) {
             *response.mutable_hash() = CreateHashId(hash.value());
         }
-        *response.mutable_add_breakpoint() = bp_resp;
+        *response.mutable_add_breakpoint() = std::move(bp_resp);
 
         LOG_INFO("Sending AddBreakpoint response: success=" + std::to_string(success) +
             ", breakpoint_type=" + std::to_string(static_cast<int>(breakpoint_type)) +
             ", breakpoint_id=" + std::to_string(breakpoint.id().id()));
-        return tcp_client_.SendProtoMessage(response);
+        return DeliverResponse(response);
     }
 
     bool DebuggerClient::SendRemoveBreakpointResponse(bool success, const std::string &error_message,
@@ -357,10 +526,39 @@ namespace Cangjie::Debugger {
         if (hash.has_value()) {
             *response.mutable_hash() = CreateHashId(hash.value());
         }
-        *response.mutable_remove_breakpoint() = remove_bp_resp;
+        *response.mutable_remove_breakpoint() = std::move(remove_bp_resp);
 
         LOG_INFO("Sending RemoveBreakpoint response: success=" + std::to_string(success));
-        return tcp_client_.SendProtoMessage(response);
+        return DeliverResponse(response);
+    }
+
+    bool DebuggerClient::SendConfigureStopSnapshotResponse(bool success, uint32_t max_frames, uint32_t max_locals,
+                                                           const std::string &error_message,
+                                                           const std::optional<uint64_t> hash) const {
+        auto configure_resp = ProtoConverter::CreateConfigureStopSnapshotResponse(success, max_frames, max_locals,
+                                                                                  error_message);
+
+        lldbprotobuf::Response response;
+        if (hash.has_value()) {
+            *response.mutable_hash() = CreateHashId(hash.value());
+        }
+        *response.mutable_configure_stop_snapshot() = std::move(configure_resp);
+
+        LOG_INFO("Sending ConfigureStopSnapshot response: success=" + std::to_string(success));
+        return DeliverResponse(response);
+    }
+
+    bool DebuggerClient::SendConfigureStringInternResponse(bool success, const std::string &error_message,
+                                                           const std::optional<uint64_t> hash) const {
+        lldbprotobuf::Response response;
+        if (hash.has_value()) {
+            *response.mutable_hash() = CreateHashId(hash.value());
+        }
+        *response.mutable_configure_string_intern() =
+            ProtoConverter::CreateConfigureStringInternResponse(success, error_message);
+
+        LOG_INFO("Sending ConfigureStringIntern response: success=" + std::to_string(success));
+        return DeliverResponse(response);
     }
 
     bool DebuggerClient::SendExecuteCommandResponse(bool success,
@@ -381,10 +579,10 @@ namespace Cangjie::Debugger {
         if (hash.has_value()) {
             *response.mutable_hash() = CreateHashId(hash.value());
         }
-        *response.mutable_execute_command() = execute_cmd_resp;
+        *response.mutable_execute_command() = std::move(execute_cmd_resp);
 
         LOG_INFO("Sending ExecuteCommand response: success=" + std::to_string(success));
-        return tcp_client_.SendProtoMessage(response);
+        return DeliverResponse(response);
     }
 
     bool DebuggerClient::SendEvaluateResponse(bool success, const lldbprotobuf::Variable &variable,
@@ -397,10 +595,10 @@ namespace Cangjie::Debugger {
             *response.mutable_hash() = CreateHashId(hash.value());
         }
 
-        *response.mutable_evaluate() = evaluate_resp;
+        *response.mutable_evaluate() = std::move(evaluate_resp);
 
         LOG_INFO("Sending Evaluate response: success=" + std::to_string(success));
-        return tcp_client_.SendProtoMessage(response);
+        return DeliverResponse(response);
     }
 
     bool DebuggerClient::SendReadMemoryResponse(bool success, uint64_t address, const std::string &data,
@@ -413,12 +611,12 @@ namespace Cangjie::Debugger {
             *response.mutable_hash() = CreateHashId(hash.value());
         }
 
-        *response.mutable_read_memory() = read_memory_resp;
+        *response.mutable_read_memory() = std::move(read_memory_resp);
 
         LOG_INFO(
             "Sending ReadMemory response: success=" + std::to_string(success) + ", address=0x" + std::to_string(address
             ));
-        return tcp_client_.SendProtoMessage(response);
+        return DeliverResponse(response);
     }
 
     bool DebuggerClient::SendWriteMemoryResponse(bool success, uint32_t bytes_written, const std::string &error_message,
@@ -430,12 +628,12 @@ namespace Cangjie::Debugger {
             *response.mutable_hash() = CreateHashId(hash.value());
         }
 
-        *response.mutable_write_memory() = write_memory_resp;
+        *response.mutable_write_memory() = std::move(write_memory_resp);
 
         LOG_INFO(
             "Sending WriteMemory response: success=" + std::to_string(success) + ", bytes_written=" + std::to_string(
                 bytes_written));
-        return tcp_client_.SendProtoMessage(response);
+        return DeliverResponse(response);
     }
 
     bool DebuggerClient::SendDisassembleResponse(bool success,
@@ -459,14 +657,14 @@ namespace Cangjie::Debugger {
             *response.mutable_hash() = CreateHashId(hash.value());
         }
 
-        *response.mutable_disassemble() = disassemble_resp;
+        *response.mutable_disassemble() = std::move(disassemble_resp);
 
         LOG_INFO("Sending Disassemble response: success=" + std::to_string(success) +
             ", instructions=" + std::to_string(instructions.size()) +
             ", bytes=" + std::to_string(bytes_disassembled) +
             ", alignment_verified=" + std::to_string(alignment_verified));
 
-        return tcp_client_.SendProtoMessage(response);
+        return DeliverResponse(response);
     }
 
     bool DebuggerClient::SendGetFunctionInfoResponse(bool success,
@@ -484,12 +682,12 @@ namespace Cangjie::Debugger {
             *response.mutable_hash() = CreateHashId(hash.value());
         }
 
-        *response.mutable_get_function_info() = function_info_resp;
+        *response.mutable_get_function_info() = std::move(function_info_resp);
 
         LOG_INFO("Sending GetFunctionInfo response: success=" + std::to_string(success) +
             ", functions=" + std::to_string(functions.size()));
 
-        return tcp_client_.SendProtoMessage(response);
+        return DeliverResponse(response);
     }
 
     bool DebuggerClient::SendRegistersResponse(bool success,
@@ -502,11 +700,11 @@ namespace Cangjie::Debugger {
         if (hash.has_value()) {
             *response.mutable_hash() = CreateHashId(hash.value());
         }
-        *response.mutable_registers() = registers_resp;
+        *response.mutable_registers() = std::move(registers_resp);
 
         LOG_INFO("Sending Registers response: success=" + std::to_string(success) +
                 ", register_count=" + std::to_string(registers.size()));
-        return tcp_client_.SendProtoMessage(response);
+        return DeliverResponse(response);
     }
 
     bool DebuggerClient::SendRegisterGroupsResponse(bool success,
@@ -519,11 +717,11 @@ namespace Cangjie::Debugger {
         if (hash.has_value()) {
             *response.mutable_hash() = CreateHashId(hash.value());
         }
-        *response.mutable_register_groups() = register_groups_resp;
+        *response.mutable_register_groups() = std::move(register_groups_resp);
 
         LOG_INFO("Sending RegisterGroups response: success=" + std::to_string(success) +
                 ", group_count=" + std::to_string(register_groups.size()));
-        return tcp_client_.SendProtoMessage(response);
+        return DeliverResponse(response);
     }
 
     bool DebuggerClient::SendCommandCompletionResponse(bool success,
@@ -548,7 +746,7 @@ namespace Cangjie::Debugger {
         if (hash.has_value()) {
             *response.mutable_hash() = CreateHashId(hash.value());
         }
-        *response.mutable_command_completion() = completion_resp;
+        *response.mutable_command_completion() = std::move(completion_resp);
 
         LOG_INFO("Sending CommandCompletion response: success=" + std::to_string(success) +
             ", completions=" + std::to_string(completions.size()) +
@@ -556,7 +754,7 @@ namespace Cangjie::Debugger {
             ", completion_start=" + std::to_string(completion_start) +
             ", has_more=" + std::to_string(has_more));
 
-        return tcp_client_.SendProtoMessage(response);
+        return DeliverResponse(response);
     }
 
 } // namespace Cangjie::Debugger
\ No newline at end of file
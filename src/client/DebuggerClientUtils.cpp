@@ -26,6 +26,10 @@
 #include "cangjie/debugger/ProtoConverter.h"
 #include "cangjie/debugger/Logger.h"
 
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
 #ifdef _WIN32
 #include <windows.h>
 #else
@@ -36,109 +40,339 @@
 #endif
 
 namespace Cangjie::Debugger {
+    namespace {
+        // 每个顶层请求用于取值（主要是摘要计算）的时间预算，用完后剩余摘要延迟计算
+        constexpr std::chrono::milliseconds SUMMARY_TIME_BUDGET{50};
+
+        constexpr uint64_t FNV_OFFSET_BASIS = 0xcbf29ce484222325ULL;
+        constexpr uint64_t FNV_PRIME = 0x100000001b3ULL;
+
+        // 按 FNV-1a 将一段字节混入哈希值
+        void Fnv1aMix(uint64_t &hash, const void *data, size_t size) {
+            const auto *bytes = static_cast<const unsigned char *>(data);
+            for (size_t i = 0; i < size; ++i) {
+                hash ^= bytes[i];
+                hash *= FNV_PRIME;
+            }
+        }
+
+        // 指纹使用的 Cangjie 摘要长度，与请求中的显示长度无关，保证各取值路径的指纹一致
+        constexpr uint32_t FINGERPRINT_SUMMARY_LENGTH = 4096;
+
+        // 值指纹：原始字节、未截断的摘要和错误信息，三者任一变化都视为值变化
+        uint64_t ValueFingerprint(const void *data, size_t size, const char *summary, const char *error) {
+            // 分隔符，避免相邻字段拼接后得到相同的字节序列
+            constexpr unsigned char separator = 0xFF;
+            uint64_t fingerprint = FNV_OFFSET_BASIS;
+            Fnv1aMix(fingerprint, data, size);
+            Fnv1aMix(fingerprint, &separator, sizeof(separator));
+            if (summary != nullptr) {
+                Fnv1aMix(fingerprint, summary, std::strlen(summary));
+            }
+            Fnv1aMix(fingerprint, &separator, sizeof(separator));
+            if (error != nullptr) {
+                Fnv1aMix(fingerprint, error, std::strlen(error));
+            }
+            return fingerprint;
+        }
+    }
 
  lldb::SBValue DebuggerClient::FindVariableById(uint64_t variable_id) const {
-  auto it = variable_id_map_.find(variable_id);
-  if (it == variable_id_map_.end()) {
-   LOG_ERROR("Variable ID not found in mapping: " + std::to_string(variable_id));
-   return lldb::SBValue();
+  // 句柄查找：一次下标访问加代数比较；之前停止代的句柄在此处自然失效
+  lldb::SBValue sb_value = variable_handles_.Find(variable_id);
+  if (sb_value.IsValid()) {
+   return sb_value;
   }
 
-  // 检查SBValue对象是否仍然有效
-  lldb::SBValue sb_value = it->second;
+  // 句柄仍有效但 SBValue 已被淘汰或已过期时，按来源透明重建
+  sb_value = RehydrateVariable(variable_id);
   if (!sb_value.IsValid()) {
-   LOG_WARNING(
-       "Found variable ID " + std::to_string(variable_id) + " but SBValue is invalid, removing from map");
-   variable_id_map_.erase(it);
-   return lldb::SBValue();
+   LOG_ERROR("Variable ID not found or stale: " + std::to_string(variable_id));
   }
-
   return sb_value;
  }
+
+    lldb::SBValue DebuggerClient::RehydrateVariable(uint64_t variable_id) const {
+        const VariableOrigin *origin = variable_handles_.FindOrigin(variable_id);
+        // 求值结果是表达式副本，重新求值可能有副作用，不重建
+        if (origin == nullptr || origin->path.empty() || origin->path.rfind("$eval:", 0) == 0) {
+            return {};
+        }
+        const VariableOrigin saved = *origin;
+
+        lldb::SBThread thread = FindThreadById(saved.thread_id);
+        if (!thread.IsValid()) {
+            return {};
+        }
+
+        // 优先按 CFA 定位原来的帧，帧索引可能因调用栈变化而不同
+        lldb::SBFrame frame;
+        if (saved.frame_cfa != 0) {
+            const uint32_t num_frames = thread.GetNumFrames();
+            for (uint32_t i = 0; i < num_frames; ++i) {
+                lldb::SBFrame candidate = thread.GetFrameAtIndex(i);
+                if (candidate.IsValid() && candidate.GetCFA() == saved.frame_cfa) {
+                    frame = candidate;
+                    break;
+                }
+            }
+        } else {
+            frame = thread.GetFrameAtIndex(saved.frame_index);
+        }
+        if (!frame.IsValid()) {
+            return {};
+        }
+
+        lldb::SBValue value = frame.GetValueForVariablePath(saved.path.c_str());
+        if (!value.IsValid() || value.GetError().Fail()) {
+            return {};
+        }
+
+        variable_handles_.Refresh(variable_id, value);
+        LOG_INFO("Rehydrated variable ID " + std::to_string(variable_id) + " from path '" + saved.path + "'");
+        return value;
+    }
+
+    void DebuggerClient::SetMaxLiveVariables(size_t max_live_variables) {
+        variable_handles_.SetMaxLiveValues(max_live_variables);
+        LOG_INFO("Variable store budget: " +
+            (max_live_variables > 0 ? std::to_string(max_live_variables) + " live values" : std::string("unlimited")));
+    }
+
     uint64_t DebuggerClient::AllocateVariableId(uint64_t thread_id, uint32_t frame_index,
-                                                lldb::SBValue &sb_value) const {
+                                                lldb::SBValue &sb_value, const std::string &path) const {
         if (!sb_value.IsValid()) {
             LOG_ERROR("Cannot allocate ID for invalid SBValue");
             return 0;
         }
 
-        // 获取变量的多个属性用于生成更唯一的哈希
-        const char *variable_name = sb_value.GetName();
-        const char *type_name = sb_value.GetTypeName();
-        uint64_t address = sb_value.GetAddress().GetLoadAddress(target_);
-        uint64_t byte_size = sb_value.GetByteSize();
-        auto current_time = std::chrono::high_resolution_clock::now();
-        auto time_stamp = current_time.time_since_epoch().count();
+        // 变量路径：如 "obj.field[2]"；调用方可直接提供（例如求值表达式）
+        std::string expression_path = path;
+        if (expression_path.empty()) {
+            lldb::SBStream stream;
+            if (sb_value.GetExpressionPath(stream) && stream.GetData() != nullptr) {
+                expression_path.assign(stream.GetData(), stream.GetSize());
+            } else if (const char *name = sb_value.GetName()) {
+                expression_path = name;
+            }
+        }
 
-        // 组合多个变量属性生成哈希
-        std::hash<std::string> str_hasher;
-        std::hash<uint64_t> num_hasher;
+        const VariableScope scope = ResolveVariableScope(thread_id, frame_index, sb_value.GetFrame());
+        const uint64_t variable_id = AcquireVariableId(scope, expression_path, sb_value);
 
-        // 组合变量名称、类型名称、地址、大小、线程ID、帧索引和时间戳
-        uint64_t name_hash = variable_name ? str_hasher(std::string(variable_name)) : 0;
-        uint64_t type_hash = type_name ? str_hasher(std::string(type_name)) : 0;
-        uint64_t combined = num_hasher(
-            thread_id ^
-            (static_cast<uint64_t>(frame_index) << 32) ^
-            address ^
-            byte_size ^
-            time_stamp ^
-            name_hash ^
-            type_hash
-        );
+        LOG_INFO("Allocated variable ID " + std::to_string(variable_id) + " for '" + expression_path +
+            "' in thread " + std::to_string(thread_id) + ", frame " + std::to_string(frame_index));
 
-        // 再进行一次哈希以确保更好的分布
-        uint64_t variable_id = num_hasher(combined + 0x9e3779b97f4a7c15); // 黄金比例常数增加随机性
+        return variable_id;
+    }
 
-        // 确保ID不为0且为正数
-        if (variable_id == 0) {
-            variable_id = 1;
+    ValueChange DebuggerClient::TrackValueChange(uint64_t variable_id, lldb::SBValue &sb_value,
+                                                 lldbprotobuf::Value *value) const {
+        // 摘要因时间预算被延迟时不再额外计算摘要，本次不记录指纹
+        if (value->summary_deferred()) {
+            value->set_value_did_change(false);
+            return ValueChange::UNKNOWN;
         }
 
-        // 直接存储SBValue对象
-        variable_id_map_[variable_id] = sb_value;
+        // 指纹基于 SBValue 本身而不是已发送的显示文本：显示文本随取值路径的截断长度、
+        // 批量解码或摘要提供器不同而不同，会在值未变化时误报变化
+        std::vector<uint8_t> bytes;
+        lldb::SBData data = sb_value.GetData();
+        if (data.IsValid() && data.GetByteSize() > 0) {
+            bytes.resize(data.GetByteSize());
+            lldb::SBError read_error;
+            bytes.resize(data.ReadRawData(read_error, 0, bytes.data(), bytes.size()));
+        }
 
-        // 获取变量名称用于日志
-        if (!variable_name) {
-            variable_name = "<unnamed>";
+        // Cangjie 内置类型的数据只是对象引用，内容变化体现在摘要中，统一以固定长度的 Cangjie 摘要参与指纹；
+        // 其余类型使用 LLDB 缓存的未截断摘要
+        std::optional<std::string> cangjie_summary;
+        if (CangjieFormatters::Classify(sb_value.GetTypeName()) != CangjieFormatters::Kind::NONE) {
+            cangjie_summary = CangjieFormatters::Summarize(sb_value, process_, FINGERPRINT_SUMMARY_LENGTH);
         }
+        const char *summary = cangjie_summary.has_value() ? cangjie_summary->c_str() : sb_value.GetSummary();
 
-        LOG_INFO("Allocated variable ID " + std::to_string(variable_id) + " for variable '" +
-            std::string(variable_name) + "' (type: " + std::string(type_name ? type_name : "unknown") +
-            ", addr: 0x" + std::to_string(address) + ", size: " + std::to_string(byte_size) +
-            ") in thread " + std::to_string(thread_id) + ", frame " + std::to_string(frame_index));
+        const lldb::SBError value_error = sb_value.GetError();
+        const char *error = value_error.Fail() ? value_error.GetCString() : nullptr;
 
-        return variable_id;
+        const uint64_t fingerprint = ValueFingerprint(bytes.data(), bytes.size(), summary, error);
+        const ValueChange change = variable_handles_.RecordFingerprint(variable_id, fingerprint);
+        value->set_value_did_change(change == ValueChange::CHANGED);
+        return change;
+    }
+
+    ValueChange DebuggerClient::TrackValueChange(uint64_t variable_id, const uint8_t *data, size_t size,
+                                                 lldbprotobuf::Value *value) const {
+        // 与 SBValue 路径相同的指纹：基本类型元素没有摘要和错误，只有原始字节
+        const uint64_t fingerprint = ValueFingerprint(data, size, nullptr, nullptr);
+        const ValueChange change = variable_handles_.RecordFingerprint(variable_id, fingerprint);
+        value->set_value_did_change(change == ValueChange::CHANGED);
+        return change;
+    }
+
+    lldb::SBExpressionOptions DebuggerClient::CreateExpressionOptions(const lldbprotobuf::EvaluateRequest &req) {
+        lldb::SBExpressionOptions options;
+        if (req.timeout_ms() > 0) {
+            options.SetTimeoutInMicroSeconds(static_cast<uint32_t>(
+                std::min<uint64_t>(static_cast<uint64_t>(req.timeout_ms()) * 1000, UINT32_MAX)));
+        }
+
+        switch (req.thread_policy()) {
+            case lldbprotobuf::EVALUATE_THREAD_POLICY_ONE_THREAD:
+                options.SetStopOthers(true);
+                options.SetTryAllThreads(false);
+                break;
+            case lldbprotobuf::EVALUATE_THREAD_POLICY_ALL_THREADS:
+                options.SetStopOthers(false);
+                break;
+            default:
+                // LLDB 默认：先只运行当前线程，单线程超时后在总超时内恢复所有线程
+                break;
+        }
+
+        if (req.no_jit()) {
+            options.SetAllowJIT(false);
+        }
+        if (req.has_unwind_on_error()) {
+            options.SetUnwindOnError(req.unwind_on_error());
+        }
+        return options;
     }
+
+    lldbprotobuf::Value DebuggerClient::CreateBudgetedValue(lldb::SBValue &sb_value, uint64_t variable_id,
+                                                            uint32_t max_string_length, bool defer_summary) const {
+        // Cangjie 内置类型的摘要只读取有界前缀，开销固定，不受时间预算限制
+        if (!defer_summary && CangjieFormatters::Classify(sb_value.GetTypeName()) != CangjieFormatters::Kind::NONE) {
+            std::optional<std::string> summary = CangjieFormatters::Summarize(sb_value, process_, max_string_length);
+            if (summary.has_value()) {
+                lldbprotobuf::Value value = ProtoConverter::CreateValue(sb_value, variable_id, max_string_length,
+                                                                        false);
+                value.set_summary(std::move(*summary));
+                value.set_summary_deferred(false);
+                return value;
+            }
+        }
+
+        const bool include_summary = !defer_summary && summary_time_spent_ < SUMMARY_TIME_BUDGET;
+
+        const auto start = std::chrono::steady_clock::now();
+        lldbprotobuf::Value value = ProtoConverter::CreateValue(sb_value, variable_id, max_string_length,
+                                                                include_summary);
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        summary_time_spent_ += elapsed;
+
+        // 摘要提供器无法中途打断，单个值超出预算时只能记录下来
+        if (include_summary && elapsed >= SUMMARY_TIME_BUDGET) {
+            LOG_WARNING("Value of variable ID " + std::to_string(variable_id) + " took " +
+                std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count()) +
+                " ms, deferring remaining summaries of this request");
+        }
+        return value;
+    }
+
+    DebuggerClient::VariableScope DebuggerClient::ResolveVariableScope(uint64_t thread_id, uint32_t frame_index,
+                                                                       lldb::SBFrame frame) const {
+        // 帧标识：优先使用 CFA（同一次调用在多次停止之间保持不变），不可用时退回到帧索引；
+        // 再混入函数起始地址，区分先后复用同一栈地址的不同函数
+        VariableScope scope;
+        scope.thread_id = thread_id;
+        scope.frame_index = frame_index;
+        scope.frame_key = frame_index;
+        if (frame.IsValid()) {
+            const lldb::addr_t cfa = frame.GetCFA();
+            if (cfa != LLDB_INVALID_ADDRESS) {
+                scope.frame_key = cfa;
+                scope.frame_cfa = cfa;
+            }
+            lldb::SBFunction function = frame.GetFunction();
+            lldb::SBAddress start = function.IsValid() ? function.GetStartAddress()
+                                                       : frame.GetSymbol().GetStartAddress();
+            scope.function_key = start.GetLoadAddress(target_);
+        }
+        return scope;
+    }
+
+    uint64_t DebuggerClient::AcquireVariableId(const VariableScope &scope, const std::string &path,
+                                               const lldb::SBValue &sb_value) const {
+        // FNV-1a 来源键：同一逻辑变量在每次停止时得到相同的键，从而复用同一句柄槽位
+        uint64_t origin_key = FNV_OFFSET_BASIS;
+        Fnv1aMix(origin_key, &scope.thread_id, sizeof(scope.thread_id));
+        Fnv1aMix(origin_key, &scope.frame_key, sizeof(scope.frame_key));
+        Fnv1aMix(origin_key, &scope.function_key, sizeof(scope.function_key));
+        Fnv1aMix(origin_key, path.data(), path.size());
+
+        VariableOrigin origin;
+        origin.thread_id = scope.thread_id;
+        origin.frame_index = scope.frame_index;
+        origin.frame_cfa = scope.frame_cfa;
+        origin.path = path;
+        return variable_handles_.Acquire(origin_key, std::move(origin), sb_value);
+    }
+
+    std::optional<uint32_t> DebuggerClient::CurrentStopId() const {
+        if (!process_.IsValid() || process_.GetState() != lldb::eStateStopped) {
+            return std::nullopt;
+        }
+        return process_.GetStopID();
+    }
+
+    void DebuggerClient::LogTypeCacheStats() const {
+        const uint64_t hits = type_cache_.GetHitCount();
+        const uint64_t total = hits + type_cache_.GetMissCount();
+        if (total == 0) {
+            return;
+        }
+        LOG_INFO("Type cache: " + std::to_string(hits) + "/" + std::to_string(total) + " hits (" +
+            std::to_string(static_cast<int>(type_cache_.GetHitRate() * 100.0)) + "%)");
+    }
+
+    void DebuggerClient::RefreshThreadIndex() const {
+        const std::optional<uint32_t> stop_id = CurrentStopId();
+        if (!stop_id) {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(thread_index_mutex_);
+        if (thread_index_stop_id_ == stop_id) {
+            return;
+        }
+
+        const uint32_t num_threads = process_.GetNumThreads();
+        thread_index_.clear();
+        thread_index_.reserve(num_threads);
+        for (uint32_t i = 0; i < num_threads; ++i) {
+            lldb::SBThread sb_thread = process_.GetThreadAtIndex(i);
+            if (sb_thread.IsValid()) {
+                thread_index_.emplace(sb_thread.GetThreadID(), sb_thread);
+            }
+        }
+        thread_index_stop_id_ = stop_id;
+        LOG_INFO("Thread index rebuilt: " + std::to_string(thread_index_.size()) + " threads, stop_id=" +
+            std::to_string(*stop_id));
+    }
+
+    lldb::SBThread DebuggerClient::FindThreadById(uint64_t thread_id) const {
+        if (!process_.IsValid()) {
+            return {};
+        }
+
+        RefreshThreadIndex();
+
+        std::lock_guard<std::mutex> lock(thread_index_mutex_);
+        if (thread_index_stop_id_.has_value() && thread_index_stop_id_ == CurrentStopId()) {
+            auto it = thread_index_.find(thread_id);
+            return it != thread_index_.end() ? it->second : lldb::SBThread();
+        }
+        return process_.GetThreadByID(thread_id);
+    }
+
     size_t DebuggerClient::CleanupInvalidVariables() const {
-     size_t cleaned_count = 0;
-     auto it = variable_id_map_.begin();
-
-     while (it != variable_id_map_.end()) {
-         if (!it->second.IsValid()) {
-             // 记录清理的变量信息
-             const char *var_name = it->second.GetName();
-             if (!var_name) {
-                 var_name = "<unnamed>";
-             }
-
-             LOG_INFO("Cleaning up invalid variable '" + std::string(var_name) +
-                 "' with ID " + std::to_string(it->first));
-
-             it = variable_id_map_.erase(it);
-             cleaned_count++;
-         } else {
-             ++it;
-         }
-     }
-
-     if (cleaned_count > 0) {
-         LOG_INFO("Cleaned up " + std::to_string(cleaned_count) + " invalid variables, " +
-             "remaining: " + std::to_string(variable_id_map_.size()));
-     }
-
-     return cleaned_count;
- }
+        const size_t cleaned_count = variable_handles_.Clear();
+        if (cleaned_count > 0) {
+            LOG_INFO("Released " + std::to_string(cleaned_count) + " variable handles");
+        }
+        return cleaned_count;
+    }
 
     // ============================================================================
     // Process Termination Utilities
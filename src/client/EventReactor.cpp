@@ -0,0 +1,347 @@
+/*
+ * Copyright 2025 LinQingYing. and contributors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * The use of this source code is governed by the Apache License 2.0,
+ * which allows users to freely use, modify, and distribute the code,
+ * provided they adhere to the terms of the license.
+ *
+ * The software is provided "as-is", and the authors are not responsible for
+ * any damages or issues arising from its use.
+ *
+ */
+
+
+#include "cangjie/debugger/EventReactor.h"
+#include "cangjie/debugger/Logger.h"
+
+#include <cerrno>
+#include <cstring>
+#include <string>
+
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+#endif
+
+namespace Cangjie::Debugger {
+
+namespace {
+    // 单次 epoll_wait 返回的最大事件数
+    constexpr int MAX_EVENTS = 16;
+}
+
+EventReactor::EventReactor()
+    : epoll_fd_(-1), wakeup_fd_(-1), running_(false), accepting_tasks_(false), next_timer_id_(1) {
+}
+
+EventReactor::~EventReactor() {
+    Close();
+}
+
+bool EventReactor::IsSupported() {
+#ifdef __linux__
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool EventReactor::IsInitialized() const {
+    return epoll_fd_ >= 0;
+}
+
+#ifdef __linux__
+
+bool EventReactor::Initialize() {
+    if (IsInitialized()) {
+        return true;
+    }
+
+    epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+    if (epoll_fd_ < 0) {
+        LOG_ERROR("Failed to create epoll instance: " + std::string(strerror(errno)));
+        return false;
+    }
+
+    wakeup_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (wakeup_fd_ < 0) {
+        LOG_ERROR("Failed to create eventfd: " + std::string(strerror(errno)));
+        Close();
+        return false;
+    }
+
+    struct epoll_event ev = {};
+    ev.events = EPOLLIN;
+    ev.data.fd = wakeup_fd_;
+    if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, wakeup_fd_, &ev) < 0) {
+        LOG_ERROR("Failed to register eventfd: " + std::string(strerror(errno)));
+        Close();
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(tasks_mutex_);
+        accepting_tasks_ = true;
+    }
+    LOG_INFO("Event reactor initialized (epoll)");
+    return true;
+}
+
+bool EventReactor::AddReadable(int fd, Callback on_readable) {
+    if (!IsInitialized()) {
+        return false;
+    }
+
+    struct epoll_event ev = {};
+    ev.events = EPOLLIN | EPOLLRDHUP;
+    ev.data.fd = fd;
+    if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &ev) < 0) {
+        LOG_ERROR("Failed to register fd " + std::to_string(fd) + ": " + std::string(strerror(errno)));
+        return false;
+    }
+
+    Handler handler;
+    handler.callback = std::move(on_readable);
+    handlers_[fd] = std::move(handler);
+    return true;
+}
+
+bool EventReactor::RemoveFd(int fd) {
+    if (!IsInitialized() || handlers_.erase(fd) == 0) {
+        return false;
+    }
+    epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+    return true;
+}
+
+uint64_t EventReactor::AddTimer(std::chrono::milliseconds interval, Callback on_expired, bool repeat) {
+    if (!IsInitialized() || interval.count() <= 0) {
+        return 0;
+    }
+
+    int timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (timer_fd < 0) {
+        LOG_ERROR("Failed to create timerfd: " + std::string(strerror(errno)));
+        return 0;
+    }
+
+    struct itimerspec spec = {};
+    spec.it_value.tv_sec = static_cast<time_t>(interval.count() / 1000);
+    spec.it_value.tv_nsec = static_cast<long>((interval.count() % 1000) * 1000000);
+    if (repeat) {
+        spec.it_interval = spec.it_value;
+    }
+    if (timerfd_settime(timer_fd, 0, &spec, nullptr) < 0) {
+        LOG_ERROR("Failed to arm timerfd: " + std::string(strerror(errno)));
+        close(timer_fd);
+        return 0;
+    }
+
+    if (!AddReadable(timer_fd, std::move(on_expired))) {
+        close(timer_fd);
+        return 0;
+    }
+
+    uint64_t timer_id = next_timer_id_++;
+    Handler &handler = handlers_[timer_fd];
+    handler.is_timer = true;
+    handler.repeat = repeat;
+    handler.timer_id = timer_id;
+    timers_[timer_id] = timer_fd;
+    return timer_id;
+}
+
+bool EventReactor::CancelTimer(uint64_t timer_id) {
+    auto it = timers_.find(timer_id);
+    if (it == timers_.end()) {
+        return false;
+    }
+    int timer_fd = it->second;
+    timers_.erase(it);
+    RemoveFd(timer_fd);
+    close(timer_fd);
+    return true;
+}
+
+void EventReactor::Wakeup() const {
+    uint64_t one = 1;
+    if (write(wakeup_fd_, &one, sizeof(one)) < 0 && errno != EAGAIN) {
+        LOG_ERROR("Failed to signal eventfd: " + std::string(strerror(errno)));
+    }
+}
+
+bool EventReactor::Post(Callback task) {
+    {
+        std::lock_guard<std::mutex> lock(tasks_mutex_);
+        if (!accepting_tasks_) {
+            return false;
+        }
+        pending_tasks_.push_back(std::move(task));
+    }
+    Wakeup();
+    return true;
+}
+
+void EventReactor::DrainPostedTasks() {
+    std::vector<Callback> tasks;
+    {
+        std::lock_guard<std::mutex> lock(tasks_mutex_);
+        tasks.swap(pending_tasks_);
+    }
+    for (auto &task : tasks) {
+        task();
+    }
+}
+
+void EventReactor::Run() {
+    if (!IsInitialized()) {
+        LOG_ERROR("Event reactor is not initialized");
+        return;
+    }
+
+    running_ = true;
+    LOG_INFO("Event reactor loop started");
+
+    struct epoll_event events[MAX_EVENTS];
+    while (running_.load()) {
+        int count = epoll_wait(epoll_fd_, events, MAX_EVENTS, -1);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            LOG_ERROR("epoll_wait failed: " + std::string(strerror(errno)));
+            break;
+        }
+
+        for (int i = 0; i < count && running_.load(); ++i) {
+            int fd = events[i].data.fd;
+
+            if (fd == wakeup_fd_) {
+                uint64_t value = 0;
+                while (read(wakeup_fd_, &value, sizeof(value)) > 0) {
+                }
+                DrainPostedTasks();
+                continue;
+            }
+
+            auto it = handlers_.find(fd);
+            if (it == handlers_.end()) {
+                // 同一批次中已被前面的回调注销
+                continue;
+            }
+
+            // 复制回调，回调内部可能注销自身
+            Handler handler = it->second;
+            if (handler.is_timer) {
+                uint64_t expirations = 0;
+                if (read(fd, &expirations, sizeof(expirations)) < 0) {
+                    continue;
+                }
+                if (!handler.repeat) {
+                    CancelTimer(handler.timer_id);
+                }
+            }
+            handler.callback();
+        }
+    }
+
+    // 停止接受新任务，并执行已投递的任务，避免事件丢失
+    {
+        std::lock_guard<std::mutex> lock(tasks_mutex_);
+        accepting_tasks_ = false;
+    }
+    DrainPostedTasks();
+
+    running_ = false;
+    LOG_INFO("Event reactor loop ended");
+}
+
+void EventReactor::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(tasks_mutex_);
+        accepting_tasks_ = false;
+    }
+    running_ = false;
+    if (wakeup_fd_ >= 0) {
+        Wakeup();
+    }
+}
+
+void EventReactor::Close() {
+    for (const auto &timer : timers_) {
+        close(timer.second);
+    }
+    timers_.clear();
+    handlers_.clear();
+
+    if (wakeup_fd_ >= 0) {
+        close(wakeup_fd_);
+        wakeup_fd_ = -1;
+    }
+    if (epoll_fd_ >= 0) {
+        close(epoll_fd_);
+        epoll_fd_ = -1;
+    }
+}
+
+#else
+
+// 非 Linux 平台：不提供事件循环，调用方回退到阻塞式消息循环
+
+bool EventReactor::Initialize() {
+    LOG_WARNING("Event reactor is not supported on this platform");
+    return false;
+}
+
+bool EventReactor::AddReadable(int, Callback) {
+    return false;
+}
+
+bool EventReactor::RemoveFd(int) {
+    return false;
+}
+
+uint64_t EventReactor::AddTimer(std::chrono::milliseconds, Callback, bool) {
+    return 0;
+}
+
+bool EventReactor::CancelTimer(uint64_t) {
+    return false;
+}
+
+void EventReactor::Wakeup() const {
+}
+
+bool EventReactor::Post(Callback) {
+    return false;
+}
+
+void EventReactor::DrainPostedTasks() {
+}
+
+void EventReactor::Run() {
+}
+
+void EventReactor::Stop() {
+}
+
+void EventReactor::Close() {
+}
+
+#endif
+
+} // namespace Cangjie::Debugger
@@ -33,70 +33,82 @@
 #include <event.pb.h>
 #include <request.pb.h>
 #include <response.pb.h>
+#include <algorithm>
 #include <vector>
 
 #ifdef _WIN32
 #include <ws2tcpip.h>
 #else
+#include <sys/select.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <arpa/inet.h>
+#include <climits>
 #include <unistd.h>
 #endif
 
 
 namespace Cangjie::Debugger {
 
-// ============================================
-// 辅助函数：确保接收指定大小的数据
-// ============================================
 namespace {
-    bool RecvExact(int socket, void* buffer, size_t size) {
-        size_t total_received = 0;
-        char* buf = static_cast<char*>(buffer);
+    // 消息大小上限（防止内存攻击）
+    constexpr uint32_t MAX_MESSAGE_SIZE = 100 * 1024 * 1024; // 100MB
 
-        while (total_received < size) {
-#ifdef _WIN32
-            int received = recv(socket, buf + total_received, size - total_received, 0);
-#else
-            ssize_t received = recv(socket, buf + total_received, size - total_received, 0);
-#endif
-            if (received <= 0) {
-                return false;
-            }
-            total_received += received;
-        }
-        return true;
-    }
+    // 帧头：4 字节消息大小（网络字节序）
+    constexpr size_t FRAME_HEADER_SIZE = 4;
 
-    bool SendExact(int socket, const void* buffer, size_t size) {
-        size_t total_sent = 0;
-        const char* buf = static_cast<const char*>(buffer);
+    // 接收缓冲区初始大小，单次 recv 最多读取缓冲区剩余空间
+    constexpr size_t INITIAL_RECEIVE_BUFFER_SIZE = 64 * 1024;
 
-        while (total_sent < size) {
-#ifdef _WIN32
-            int sent = send(socket, buf + total_sent, size - total_sent, 0);
-#else
-            ssize_t sent = send(socket, buf + total_sent, size - total_sent, 0);
-#endif
-            if (sent <= 0) {
-                return false;
-            }
-            total_sent += sent;
+    // 发送帧缓冲池：最多缓存的帧数及可回收的最大缓冲区容量
+    constexpr size_t MAX_POOLED_FRAMES = 32;
+    constexpr size_t MAX_POOLED_FRAME_CAPACITY = 1024 * 1024;
+
+    // 单次批量写的最大帧数（每帧对应一个 iovec）
+    constexpr size_t MAX_BATCH_FRAMES = 64;
+
+    // 原子地更新最大值
+    void UpdateMax(std::atomic<uint64_t>& target, uint64_t value) {
+        uint64_t current = target.load(std::memory_order_relaxed);
+        while (value > current &&
+               !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
         }
-        return true;
     }
 }
 
+struct TcpClient::OutboundFrame {
+    std::atomic<OutboundFrame*> next{nullptr};
+    std::vector<char> data;
+    std::chrono::steady_clock::time_point enqueue_time;
+};
+
 TcpClient::TcpClient()
     : socket_(0), connected_(false)
 #ifdef _WIN32
     , wsa_initialized_(false)
 #endif
+    , recv_buffer_(INITIAL_RECEIVE_BUFFER_SIZE), recv_begin_(0), recv_end_(0)
+    , pending_requests_(), pending_head_(0), pending_count_(0)
+    , queue_head_(nullptr), queue_tail_(nullptr), queue_stub_(new OutboundFrame())
+    , writer_running_(false), write_failed_(false)
+    , queue_depth_(0), max_queue_depth_(0), frames_sent_(0), bytes_sent_(0)
+    , batches_sent_(0), total_latency_us_(0), max_latency_us_(0)
 {
+    queue_head_.store(queue_stub_, std::memory_order_relaxed);
+    queue_tail_ = queue_stub_;
 }
 
 TcpClient::~TcpClient() {
     Disconnect();
+
+    // 释放未发送的帧
+    while (OutboundFrame* frame = PopFrame()) {
+        delete frame;
+    }
+    delete queue_stub_;
+    for (auto* frame : frame_pool_) {
+        delete frame;
+    }
 }
 
 bool TcpClient::Connect(const std::string& host, int port) {
@@ -156,11 +168,16 @@ bool TcpClient::Connect(const std::string& host, int port) {
     }
 
     connected_ = true;
+    write_failed_ = false;
+    StartWriterThread();
     LOG_INFO("Successfully connected to " + host + ":" + std::to_string(port));
     return true;
 }
 
 void TcpClient::Disconnect() {
+    // 先停止写线程，确保已入队的帧在关闭 socket 前写出
+    StopWriterThread();
+
     if (!connected_) {
         return;
     }
@@ -176,103 +193,304 @@ void TcpClient::Disconnect() {
 #endif
 
     connected_ = false;
-    LOG_INFO("Disconnected from server");
+
+    const TcpSendStats stats = GetSendStats();
+    LOG_INFO("Disconnected from server, frames sent: " + std::to_string(stats.frames_sent) +
+             ", max queue depth: " + std::to_string(stats.max_queue_depth) +
+             ", max send latency: " + std::to_string(stats.max_latency_us) + " us");
 }
 
 bool TcpClient::IsConnected() const {
     return connected_;
 }
 
+SOCKET_TYPE TcpClient::GetSocket() const {
+    return socket_;
+}
+
+TcpSendStats TcpClient::GetSendStats() const {
+    TcpSendStats stats;
+    stats.frames_sent = frames_sent_.load(std::memory_order_relaxed);
+    stats.bytes_sent = bytes_sent_.load(std::memory_order_relaxed);
+    stats.batches_sent = batches_sent_.load(std::memory_order_relaxed);
+    stats.queue_depth = queue_depth_.load(std::memory_order_relaxed);
+    stats.max_queue_depth = max_queue_depth_.load(std::memory_order_relaxed);
+    stats.total_latency_us = total_latency_us_.load(std::memory_order_relaxed);
+    stats.max_latency_us = max_latency_us_.load(std::memory_order_relaxed);
+    return stats;
+}
+
 // ============================================
-// 优化版本：一次发送（前4字节大小 + 消息内容）
+// 无锁发送队列（多生产者单消费者）
 // ============================================
-bool TcpClient::SendProtoMessage(const lldbprotobuf::Response& response) const {
+void TcpClient::PushFrame(OutboundFrame* frame) const {
+    frame->next.store(nullptr, std::memory_order_relaxed);
+    OutboundFrame* prev = queue_head_.exchange(frame, std::memory_order_acq_rel);
+    prev->next.store(frame, std::memory_order_release);
+}
+
+TcpClient::OutboundFrame* TcpClient::PopFrame() const {
+    OutboundFrame* tail = queue_tail_;
+    OutboundFrame* next = tail->next.load(std::memory_order_acquire);
+
+    // 跳过哨兵节点
+    if (tail == queue_stub_) {
+        if (next == nullptr) {
+            return nullptr;
+        }
+        queue_tail_ = next;
+        tail = next;
+        next = next->next.load(std::memory_order_acquire);
+    }
+
+    if (next != nullptr) {
+        queue_tail_ = next;
+        return tail;
+    }
+
+    // tail 不是最后一个节点，说明有生产者正在链接，稍后再取
+    if (tail != queue_head_.load(std::memory_order_acquire)) {
+        return nullptr;
+    }
+
+    // 队列中只剩一个节点：重新放入哨兵，使该节点可以被取出
+    PushFrame(queue_stub_);
+    next = tail->next.load(std::memory_order_acquire);
+    if (next != nullptr) {
+        queue_tail_ = next;
+        return tail;
+    }
+    return nullptr;
+}
+
+TcpClient::OutboundFrame* TcpClient::AcquireFrame(size_t frame_size) const {
+    OutboundFrame* frame = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(frame_pool_mutex_);
+        if (!frame_pool_.empty()) {
+            frame = frame_pool_.back();
+            frame_pool_.pop_back();
+        }
+    }
+    if (frame == nullptr) {
+        frame = new OutboundFrame();
+    }
+    // 复用已有容量，只有更大的消息才会重新分配
+    frame->data.resize(frame_size);
+    return frame;
+}
+
+void TcpClient::ReleaseFrame(OutboundFrame* frame) const {
+    // 过大的缓冲区不回收，避免长期占用内存
+    if (frame->data.capacity() <= MAX_POOLED_FRAME_CAPACITY) {
+        std::lock_guard<std::mutex> lock(frame_pool_mutex_);
+        if (frame_pool_.size() < MAX_POOLED_FRAMES) {
+            frame_pool_.push_back(frame);
+            return;
+        }
+    }
+    delete frame;
+}
+
+bool TcpClient::EnqueueMessage(const lldbprotobuf::Response& response, const char* kind) const {
     if (!connected_) {
         LOG_ERROR("Not connected to server");
         return false;
     }
 
-    // 序列化 protobuf 消息
-    std::string serialized;
-    if (!response.SerializeToString(&serialized)) {
-        LOG_ERROR("Failed to serialize protobuf message");
+    if (write_failed_.load(std::memory_order_acquire)) {
+        LOG_ERROR("Writer thread has failed, dropping " + std::string(kind) + " message");
         return false;
     }
 
-    auto message_size = static_cast<uint32_t>(serialized.size());
-
-
-
-    // 验证消息大小合理性
-    constexpr uint32_t MAX_MESSAGE_SIZE = 100 * 1024 * 1024; // 100MB
-    if (message_size == 0 || message_size > MAX_MESSAGE_SIZE) {
-        LOG_ERROR("Invalid message size: " + std::to_string(message_size));
+    // 先计算大小（同时缓存各子消息大小），再直接序列化到帧缓冲区的长度头之后
+    size_t byte_size = response.ByteSizeLong();
+    if (byte_size == 0 || byte_size > MAX_MESSAGE_SIZE) {
+        LOG_ERROR("Invalid " + std::string(kind) + " message size: " + std::to_string(byte_size));
         return false;
     }
+    auto message_size = static_cast<uint32_t>(byte_size);
 
     // 构造完整数据包：[4字节大小(网络字节序)][消息内容]
-    std::vector<char> packet(4 + message_size);
+    OutboundFrame* frame = AcquireFrame(FRAME_HEADER_SIZE + message_size);
     uint32_t network_size = htonl(message_size);
-
-    // 复制大小头部
-    std::memcpy(packet.data(), &network_size, 4);
-    // 复制消息内容
-    std::memcpy(packet.data() + 4, serialized.data(), message_size);
-
-    // 一次性发送完整数据包
-    if (!SendExact(socket_, packet.data(), packet.size())) {
-        LOG_ERROR("Failed to send protobuf message");
-        return false;
+    std::memcpy(frame->data.data(), &network_size, FRAME_HEADER_SIZE);
+    response.SerializeWithCachedSizesToArray(
+        reinterpret_cast<uint8_t*>(frame->data.data() + FRAME_HEADER_SIZE));
+    frame->enqueue_time = std::chrono::steady_clock::now();
+
+    // 先计数再入队：写线程弹出并扣减计数时，计数必然已包含该帧，不会下溢
+    uint64_t depth = queue_depth_.fetch_add(1, std::memory_order_acq_rel) + 1;
+    UpdateMax(max_queue_depth_, depth);
+    PushFrame(frame);
+
+    // 仅在唤醒写线程时短暂持锁，避免丢失通知
+    {
+        std::lock_guard<std::mutex> lock(writer_mutex_);
     }
+    writer_cv_.notify_one();
 
-    LOG_INFO("Sent protobuf message of size: " + std::to_string(message_size) + " bytes");
+    LOG_INFO("Queued " + std::string(kind) + " message of size: " + std::to_string(message_size) + " bytes");
     return true;
 }
 
-bool TcpClient::SendEventBroadcast(const lldbprotobuf::Event& event) const {
-    if (!connected_) {
-        LOG_ERROR("Not connected to server");
-        return false;
+// ============================================
+// 写线程
+// ============================================
+void TcpClient::StartWriterThread() {
+    if (writer_thread_.joinable()) {
+        return;
     }
+    writer_running_ = true;
+    writer_thread_ = std::thread(&TcpClient::WriterThreadLoop, this);
+}
 
+void TcpClient::StopWriterThread() {
+    if (!writer_thread_.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(writer_mutex_);
+        writer_running_ = false;
+    }
+    writer_cv_.notify_one();
+    writer_thread_.join();
+}
 
+void TcpClient::WriterThreadLoop() {
+    LOG_INFO("Writer thread started");
 
-    // 将广播包装到 CompositeResponse 中
-    lldbprotobuf::Response response;
-    response.mutable_event()->CopyFrom(event);
+    std::vector<OutboundFrame*> batch;
+    batch.reserve(MAX_BATCH_FRAMES);
 
-    // 序列化 protobuf 消息
-    std::string serialized;
-    if (!response.SerializeToString(&serialized)) {
-        LOG_ERROR("Failed to serialize broadcast message");
-        return false;
-    }
+    while (true) {
+        batch.clear();
+        while (batch.size() < MAX_BATCH_FRAMES) {
+            OutboundFrame* frame = PopFrame();
+            if (frame == nullptr) {
+                break;
+            }
+            batch.push_back(frame);
+        }
 
-    auto message_size = static_cast<uint32_t>(serialized.size());
+        if (batch.empty()) {
+            if (!writer_running_.load(std::memory_order_acquire)) {
+                break;
+            }
+            if (queue_depth_.load(std::memory_order_acquire) > 0) {
+                // 生产者正在链接节点，让出时间片后重试
+                std::this_thread::yield();
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(writer_mutex_);
+            writer_cv_.wait(lock, [this] {
+                return queue_depth_.load(std::memory_order_acquire) > 0 ||
+                       !writer_running_.load(std::memory_order_acquire);
+            });
+            continue;
+        }
 
-    // 验证消息大小合理性
-    constexpr uint32_t MAX_MESSAGE_SIZE = 100 * 1024 * 1024; // 100MB
-    if (message_size == 0 || message_size > MAX_MESSAGE_SIZE) {
-        LOG_ERROR("Invalid broadcast size: " + std::to_string(message_size));
-        return false;
+        queue_depth_.fetch_sub(batch.size(), std::memory_order_acq_rel);
+
+        if (!write_failed_.load(std::memory_order_acquire)) {
+            if (WriteBatch(batch)) {
+                auto now = std::chrono::steady_clock::now();
+                uint64_t batch_bytes = 0;
+                for (const auto* frame : batch) {
+                    auto latency = static_cast<uint64_t>(
+                        std::chrono::duration_cast<std::chrono::microseconds>(now - frame->enqueue_time).count());
+                    total_latency_us_.fetch_add(latency, std::memory_order_relaxed);
+                    UpdateMax(max_latency_us_, latency);
+                    batch_bytes += frame->data.size();
+                }
+                frames_sent_.fetch_add(batch.size(), std::memory_order_relaxed);
+                bytes_sent_.fetch_add(batch_bytes, std::memory_order_relaxed);
+                batches_sent_.fetch_add(1, std::memory_order_relaxed);
+            } else {
+                LOG_ERROR("Failed to write " + std::to_string(batch.size()) + " queued frames");
+                write_failed_ = true;
+            }
+        }
+
+        for (auto* frame : batch) {
+            ReleaseFrame(frame);
+        }
     }
 
-    // 构造完整数据包：[4字节大小(网络字节序)][消息内容]
-    std::vector<char> packet(4 + message_size);
-    uint32_t network_size = htonl(message_size);
+    LOG_INFO("Writer thread stopped");
+}
 
-    // 复制大小头部
-    std::memcpy(packet.data(), &network_size, 4);
-    // 复制消息内容
-    std::memcpy(packet.data() + 4, serialized.data(), message_size);
+bool TcpClient::WriteBatch(const std::vector<OutboundFrame*>& batch) const {
+    size_t index = 0;     // 当前正在写的帧
+    size_t offset = 0;    // 当前帧已写出的字节数
 
-    // 一次性发送完整数据包
-    if (!SendExact(socket_, packet.data(), packet.size())) {
-        LOG_ERROR("Failed to send broadcast message");
+    while (index < batch.size()) {
+#ifdef _WIN32
+        WSABUF buffers[MAX_BATCH_FRAMES];
+        DWORD count = 0;
+        for (size_t i = index; i < batch.size(); ++i, ++count) {
+            size_t skip = (i == index) ? offset : 0;
+            buffers[count].buf = const_cast<char*>(batch[i]->data.data() + skip);
+            buffers[count].len = static_cast<ULONG>(batch[i]->data.size() - skip);
+        }
+        DWORD sent_bytes = 0;
+        if (WSASend(socket_, buffers, count, &sent_bytes, 0, nullptr, nullptr) != 0) {
+            return false;
+        }
+        size_t sent = sent_bytes;
+#else
+        struct iovec buffers[MAX_BATCH_FRAMES];
+        int count = 0;
+        for (size_t i = index; i < batch.size() && count < IOV_MAX; ++i, ++count) {
+            size_t skip = (i == index) ? offset : 0;
+            buffers[count].iov_base = const_cast<char*>(batch[i]->data.data() + skip);
+            buffers[count].iov_len = batch[i]->data.size() - skip;
+        }
+        ssize_t written = writev(socket_, buffers, count);
+        if (written < 0 && errno == EINTR) {
+            continue;
+        }
+        if (written <= 0) {
+            return false;
+        }
+        auto sent = static_cast<size_t>(written);
+#endif
+        // 根据实际写出的字节数推进（处理部分写）
+        while (sent > 0 && index < batch.size()) {
+            size_t remaining = batch[index]->data.size() - offset;
+            if (sent >= remaining) {
+                sent -= remaining;
+                ++index;
+                offset = 0;
+            } else {
+                offset += sent;
+                sent = 0;
+            }
+        }
+    }
+    return true;
+}
+
+// ============================================
+// 序列化后入队，由写线程发送（前4字节大小 + 消息内容）
+// ============================================
+bool TcpClient::SendProtoMessage(const lldbprotobuf::Response& response) const {
+    if (!EnqueueMessage(response, "protobuf")) {
+        LOG_ERROR("Failed to send protobuf message");
         return false;
     }
+    return true;
+}
 
-    LOG_INFO("Sent broadcast message of size: " + std::to_string(message_size) + " bytes");
+bool TcpClient::SendEventBroadcast(const lldbprotobuf::Response& event_response) const {
+    if (!event_response.has_event()) {
+        LOG_ERROR("Broadcast envelope does not contain an event");
+        return false;
+    }
+    if (!EnqueueMessage(event_response, "broadcast")) {
+        LOG_ERROR("Failed to send broadcast message");
+        return false;
+    }
     return true;
 }
 
@@ -282,6 +500,14 @@ bool TcpClient::ReceiveData(char* buffer, size_t buffer_size, size_t& bytes_rece
         return false;
     }
 
+    // 优先返回接收缓冲区中尚未解析的数据
+    if (recv_end_ > recv_begin_) {
+        bytes_received = std::min(buffer_size, recv_end_ - recv_begin_);
+        std::memcpy(buffer, recv_buffer_.data() + recv_begin_, bytes_received);
+        recv_begin_ += bytes_received;
+        return true;
+    }
+
 #ifdef _WIN32
     int received = recv(socket_, buffer, buffer_size, 0);
 #else
@@ -303,56 +529,168 @@ bool TcpClient::ReceiveData(char* buffer, size_t buffer_size, size_t& bytes_rece
 }
 
 // ============================================
-// 优化版本：使用 RecvExact 确保完整接收
+// 缓冲读取：一次 recv 读取尽可能多的数据，并解析其中所有完整帧
 // ============================================
-bool TcpClient::ReceiveProtoMessage(lldbprotobuf::Request& request) const {
-    if (!connected_) {
-        LOG_ERROR("Not connected to server");
-        return false;
+bool TcpClient::FillReceiveBuffer(bool nonblocking) const {
+    // 缓冲区已全部解析时复位，避免移动数据
+    if (recv_begin_ == recv_end_) {
+        recv_begin_ = 0;
+        recv_end_ = 0;
     }
 
-    // 接收 4 字节消息大小（使用 RecvExact 确保完整接收）
-    uint32_t network_size;
-    if (!RecvExact(socket_, &network_size, 4)) {
-        LOG_ERROR("Failed to receive message size");
-        return false;
+    // 计算当前不完整帧需要的总空间
+    size_t buffered = recv_end_ - recv_begin_;
+    size_t required = FRAME_HEADER_SIZE;
+    if (buffered >= FRAME_HEADER_SIZE) {
+        uint32_t network_size;
+        std::memcpy(&network_size, recv_buffer_.data() + recv_begin_, FRAME_HEADER_SIZE);
+        required = FRAME_HEADER_SIZE + ntohl(network_size);
     }
 
-    // 转换为主机字节序
-    uint32_t message_size = ntohl(network_size);
+    // 尾部空间放不下当前帧时，把剩余数据移到缓冲区开头；仍不足则扩容
+    if (recv_begin_ + required > recv_buffer_.size() || recv_end_ == recv_buffer_.size()) {
+        if (recv_begin_ > 0) {
+            std::memmove(recv_buffer_.data(), recv_buffer_.data() + recv_begin_, buffered);
+            recv_begin_ = 0;
+            recv_end_ = buffered;
+        }
+        if (recv_buffer_.size() < required) {
+            recv_buffer_.resize(required);
+        }
+    }
 
-    // 验证消息大小合理性（防止内存攻击）
-    constexpr uint32_t MAX_MESSAGE_SIZE = 100 * 1024 * 1024; // 100MB
-    if (message_size > MAX_MESSAGE_SIZE) {
-        LOG_ERROR("Invalid message size: " + std::to_string(message_size));
+#ifdef _WIN32
+    (void)nonblocking;
+    int received = recv(socket_, recv_buffer_.data() + recv_end_,
+                        static_cast<int>(recv_buffer_.size() - recv_end_), 0);
+#else
+    ssize_t received = recv(socket_, recv_buffer_.data() + recv_end_, recv_buffer_.size() - recv_end_,
+                            nonblocking ? MSG_DONTWAIT : 0);
+    if (received < 0 && (errno == EINTR || (nonblocking && (errno == EAGAIN || errno == EWOULDBLOCK)))) {
+        return true;
+    }
+#endif
+
+    if (received <= 0) {
+        if (received == 0) {
+            LOG_INFO("Connection closed by server");
+        } else {
+            LOG_ERROR("Failed to receive data");
+        }
         return false;
     }
 
-    // 处理空消息（size 0）- 跳过处理但不返回错误
-    if (message_size == 0) {
-        LOG_INFO("Received empty message (size 0), skipping");
-        // 将request清空以确保这是一个有效的空消息
-        request.Clear();
-        return true;
+    recv_end_ += static_cast<size_t>(received);
+    return true;
+}
+
+bool TcpClient::DecodeBufferedFrames() const {
+    while (recv_end_ - recv_begin_ >= FRAME_HEADER_SIZE) {
+        // 读取 4 字节消息大小并转换为主机字节序
+        uint32_t network_size;
+        std::memcpy(&network_size, recv_buffer_.data() + recv_begin_, FRAME_HEADER_SIZE);
+        uint32_t message_size = ntohl(network_size);
+
+        // 验证消息大小合理性（防止内存攻击）
+        if (message_size > MAX_MESSAGE_SIZE) {
+            LOG_ERROR("Invalid message size: " + std::to_string(message_size));
+            return false;
+        }
+
+        // 帧不完整，等待更多数据
+        if (recv_end_ - recv_begin_ < FRAME_HEADER_SIZE + message_size) {
+            break;
+        }
+
+        const char* payload = recv_buffer_.data() + recv_begin_ + FRAME_HEADER_SIZE;
+        recv_begin_ += FRAME_HEADER_SIZE + message_size;
+
+        // 处理空消息（size 0）- 跳过处理但不返回错误
+        if (message_size == 0) {
+            LOG_INFO("Received empty message (size 0), skipping");
+            continue;
+        }
+
+        // 复用已有的请求对象，直接在接收缓冲区上解析
+        if (pending_count_ == pending_requests_.size()) {
+            pending_requests_.emplace_back();
+        }
+        lldbprotobuf::Request& slot = pending_requests_[pending_count_];
+        if (!slot.ParseFromArray(payload, static_cast<int>(message_size))) {
+            LOG_ERROR("Failed to parse protobuf message");
+            return false;
+        }
+        ++pending_count_;
+
+        LOG_INFO("Received protobuf message of size: " + std::to_string(message_size) + " bytes");
     }
+    return true;
+}
 
-    // 分配接收缓冲区
-    std::vector<char> message_data(message_size);
+bool TcpClient::HasBufferedRequests() const {
+    return pending_head_ < pending_count_;
+}
 
-    // 接收完整消息内容（使用 RecvExact 确保完整接收）
-    if (!RecvExact(socket_, message_data.data(), message_size)) {
-        LOG_ERROR("Failed to receive message data");
+bool TcpClient::ReceiveAvailable() const {
+    if (!connected_) {
+        LOG_ERROR("Not connected to server");
         return false;
     }
+    return FillReceiveBuffer(true) && DecodeBufferedFrames();
+}
 
-    // 解析 protobuf 消息
-    if (!request.ParseFromArray(message_data.data(), message_size)) {
-        LOG_ERROR("Failed to parse protobuf message");
+int TcpClient::WaitReadable(int timeout_ms) const {
+    if (HasBufferedRequests()) {
+        return 1;
+    }
+    fd_set read_set;
+    FD_ZERO(&read_set);
+    FD_SET(socket_, &read_set);
+    timeval timeout{};
+    timeout.tv_sec = timeout_ms / 1000;
+    timeout.tv_usec = (timeout_ms % 1000) * 1000;
+#ifdef _WIN32
+    int ready = select(0, &read_set, nullptr, nullptr, &timeout);
+#else
+    int ready = select(socket_ + 1, &read_set, nullptr, nullptr, &timeout);
+    if (ready < 0 && errno == EINTR) {
+        return 0;
+    }
+#endif
+    if (ready < 0) {
+        LOG_ERROR("Failed to wait for socket readability");
+        return -1;
+    }
+    return ready > 0 ? 1 : 0;
+}
+
+bool TcpClient::ReceiveProtoMessage(lldbprotobuf::Request& request) const {
+    if (!connected_) {
+        LOG_ERROR("Not connected to server");
         return false;
     }
 
+    // 队列为空时才读取 socket，一次 recv 可能解码出多个请求
+    while (pending_head_ == pending_count_) {
+        if (!DecodeBufferedFrames()) {
+            return false;
+        }
+        if (pending_head_ < pending_count_) {
+            break;
+        }
+        if (!FillReceiveBuffer()) {
+            return false;
+        }
+    }
+
+    request.Swap(&pending_requests_[pending_head_]);
+    ++pending_head_;
 
-    LOG_INFO("Received protobuf message of size: " + std::to_string(message_size) + " bytes");
+    // 队列已取空，复位以便复用请求对象
+    if (pending_head_ == pending_count_) {
+        pending_head_ = 0;
+        pending_count_ = 0;
+    }
     return true;
 }
 
@@ -216,7 +216,7 @@ BreakpointCreateResult BreakpointManager::CreateLineBreakpoint(
 
     // 设置断点属性
     if (!condition.empty()) {
-        lldb_bp.SetCondition(condition.c_str());
+        ApplyCondition(lldb_bp, condition, ignore_count);
     }
 
     lldb_bp.SetEnabled(enabled);
@@ -297,7 +297,7 @@ BreakpointCreateResult BreakpointManager::CreateAddressBreakpoint(
 
     // 设置断点属性
     if (!condition.empty()) {
-        lldb_bp.SetCondition(condition.c_str());
+        ApplyCondition(lldb_bp, condition, ignore_count);
     }
 
     lldb_bp.SetEnabled(enabled);
@@ -342,7 +342,7 @@ BreakpointCreateResult BreakpointManager::CreateFunctionBreakpoint(
 
     // 设置断点属性
     if (!condition.empty()) {
-        lldb_bp.SetCondition(condition.c_str());
+        ApplyCondition(lldb_bp, condition, ignore_count);
     }
 
     lldb_bp.SetEnabled(enabled);
@@ -430,7 +430,7 @@ BreakpointCreateResult BreakpointManager::CreateSymbolBreakpoint(
 
     // 设置断点属性
     if (!condition.empty()) {
-        lldb_bp.SetCondition(condition.c_str());
+        ApplyCondition(lldb_bp, condition, ignore_count);
     }
 
     lldb_bp.SetEnabled(enabled);
@@ -573,6 +573,7 @@ bool BreakpointManager::RemoveBreakpointById(int64_t breakpoint_id, std::string&
 
     // 从管理器中移除
     breakpoints_by_id_.erase(it);
+    RemoveCompiledCondition(breakpoint_id);
 
     LOG_INFO("Removed breakpoint/watchpoint with ID " + std::to_string(breakpoint_id));
     return true;
@@ -612,7 +613,7 @@ bool BreakpointManager::SetBreakpointCondition(int64_t breakpoint_id, const std:
         return false;
     }
 
-    lldb_bp.SetCondition(condition.c_str());
+    ApplyCondition(lldb_bp, condition, it->second->ignore_count);
     it->second->condition = condition;
 
     LOG_INFO("Set condition for breakpoint " + std::to_string(breakpoint_id) + ": " + condition);
@@ -634,6 +635,10 @@ bool BreakpointManager::SetBreakpointIgnoreCount(int64_t breakpoint_id, uint32_t
 
     lldb_bp.SetIgnoreCount(ignore_count);
     it->second->ignore_count = ignore_count;
+    if (!it->second->condition.empty()) {
+        // 忽略计数决定条件能否编译执行，重新选择求值方式
+        ApplyCondition(lldb_bp, it->second->condition, ignore_count);
+    }
 
     LOG_INFO("Set ignore count for breakpoint " + std::to_string(breakpoint_id) + ": " +
              std::to_string(ignore_count));
@@ -699,6 +704,10 @@ void BreakpointManager::ClearAllBreakpoints(std::string& error_message) {
     // 清空管理器中的断点
     breakpoints_by_id_.clear();
     legacy_breakpoints_.clear();
+    for (auto& pair : compiled_conditions_) {
+        RetireCondition(std::move(pair.second));
+    }
+    compiled_conditions_.clear();
 
     if (!has_error) {
         error_message.clear(); // 如果没有错误，清空错误消息
@@ -857,6 +866,90 @@ lldbprotobuf::SourceLocation* BreakpointManager::CreateProtoSourceLocation(
     return location.release();
 }
 
+void BreakpointManager::ApplyCondition(lldb::SBBreakpoint& lldb_bp, const std::string& condition,
+                                       uint32_t ignore_count) {
+    const int64_t breakpoint_id = lldb_bp.GetID();
+    RemoveCompiledCondition(breakpoint_id);
+
+    if (!condition.empty() && ignore_count == 0) {
+        std::optional<Cangjie::Debugger::ConditionProgram> program =
+            Cangjie::Debugger::ConditionCompiler::Compile(condition);
+        if (program.has_value()) {
+            auto owned = std::make_unique<Cangjie::Debugger::ConditionProgram>(std::move(*program));
+            lldb_bp.SetCondition("");
+            lldb_bp.SetCallback(&BreakpointManager::CompiledConditionCallback, owned.get());
+            LOG_INFO("Compiled condition for breakpoint " + std::to_string(breakpoint_id) + " into " +
+                     std::to_string(owned->GetInstructionCount()) + " instructions: " + condition);
+            compiled_conditions_[breakpoint_id] = std::move(owned);
+            return;
+        }
+        LOG_INFO("Condition for breakpoint " + std::to_string(breakpoint_id) +
+                 " is evaluated by the expression engine: " + condition);
+    }
+    lldb_bp.SetCondition(condition.c_str());
+}
+
+void BreakpointManager::RemoveCompiledCondition(int64_t breakpoint_id) {
+    auto it = compiled_conditions_.find(breakpoint_id);
+    if (it == compiled_conditions_.end()) {
+        return;
+    }
+    lldb::SBBreakpoint lldb_bp = target_.FindBreakpointByID(breakpoint_id);
+    if (lldb_bp.IsValid()) {
+        lldb_bp.SetCallback(nullptr, nullptr);
+    }
+    RetireCondition(std::move(it->second));
+    compiled_conditions_.erase(it);
+}
+
+void BreakpointManager::RetireCondition(std::unique_ptr<Cangjie::Debugger::ConditionProgram> program) {
+    RetiredCondition retired;
+    retired.pulled_events = pulled_events_.load(std::memory_order_acquire);
+    retired.program = std::move(program);
+    retired_conditions_.push_back(std::move(retired));
+}
+
+uint64_t BreakpointManager::NotePulledEvent() {
+    return pulled_events_.fetch_add(1, std::memory_order_acq_rel) + 1;
+}
+
+void BreakpointManager::ReleaseRetiredConditions(uint64_t event_sequence) {
+    // 替换时已取出 n 个事件，则当时可能正在执行的回调属于第 n + 1 个事件；列表按替换顺序排列
+    auto end = retired_conditions_.begin();
+    while (end != retired_conditions_.end() && end->pulled_events < event_sequence) {
+        ++end;
+    }
+    if (end == retired_conditions_.begin()) {
+        return;
+    }
+    LOG_INFO("Released " + std::to_string(end - retired_conditions_.begin()) + " retired breakpoint conditions");
+    retired_conditions_.erase(retired_conditions_.begin(), end);
+}
+
+bool BreakpointManager::CompiledConditionCallback(void* baton, lldb::SBProcess& process, lldb::SBThread& thread,
+                                                  lldb::SBBreakpointLocation& location) {
+    const auto* program = static_cast<const Cangjie::Debugger::ConditionProgram*>(baton);
+    if (program == nullptr) {
+        return true;
+    }
+
+    // 返回 false 时 LLDB 不上报停止，直接继续运行
+    lldb::SBFrame frame = thread.GetFrameAtIndex(0);
+    const std::optional<bool> result = program->Evaluate(process, frame);
+    if (result.has_value()) {
+        return *result;
+    }
+
+    // 本次命中无法直接读取（变量不在作用域、不是基本类型等），按原始条件交给表达式引擎
+    lldb::SBValue value = frame.EvaluateExpression(program->GetSource().c_str());
+    if (value.IsValid() && value.GetError().Success()) {
+        return value.GetValueAsUnsigned(0) != 0;
+    }
+    LOG_WARNING("Failed to evaluate condition '" + program->GetSource() + "' at breakpoint location " +
+                std::to_string(location.GetID()) + ", stopping");
+    return true;
+}
+
 
 } // namespace debugger
 } // namespace cangjie
\ No newline at end of file
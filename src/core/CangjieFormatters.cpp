@@ -0,0 +1,297 @@
+/*
+ * Copyright 2025 LinQingYing. and contributors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * The use of this source code is governed by the Apache License 2.0,
+ * which allows users to freely use, modify, and distribute the code,
+ * provided they adhere to the terms of the license.
+ *
+ * The software is provided "as-is", and the authors are not responsible for
+ * any damages or issues arising from its use.
+ *
+ */
+
+
+#include "cangjie/debugger/CangjieFormatters.h"
+#include "cangjie/debugger/PrimitiveArrayDecoder.h"
+
+#include <algorithm>
+#include <initializer_list>
+#include <vector>
+
+namespace Cangjie::Debugger {
+
+namespace {
+    // 集合摘要中最多展示的元素个数
+    constexpr uint64_t SUMMARY_MAX_ELEMENTS = 16;
+
+    /**
+     * @brief 取类型的基本名：去掉泛型参数和包名前缀，如 "std.collection::ArrayList<Int64>" -> "ArrayList"
+     */
+    std::string BaseTypeName(const char* type_name) {
+        std::string name = type_name;
+        const size_t generic = name.find('<');
+        if (generic != std::string::npos) {
+            name.resize(generic);
+        }
+        const size_t separator = name.find_last_of(":.");
+        if (separator != std::string::npos) {
+            name.erase(0, separator + 1);
+        }
+        return name;
+    }
+
+    /**
+     * @brief 按候选名称查找成员（绕过合成子变量，引用类型先解引用）
+     */
+    lldb::SBValue Member(lldb::SBValue& value, std::initializer_list<const char*> names) {
+        lldb::SBValue raw = value.GetNonSyntheticValue();
+        if (raw.GetType().IsPointerType() || raw.GetType().IsReferenceType()) {
+            raw = raw.Dereference();
+        }
+        for (const char* name : names) {
+            lldb::SBValue member = raw.GetChildMemberWithName(name);
+            if (member.IsValid()) {
+                return member;
+            }
+        }
+        return {};
+    }
+
+    std::optional<uint64_t> UnsignedMember(lldb::SBValue& value, std::initializer_list<const char*> names) {
+        lldb::SBValue member = Member(value, names);
+        if (!member.IsValid()) {
+            return std::nullopt;
+        }
+        lldb::SBError error;
+        const uint64_t result = member.GetValueAsUnsigned(error, 0);
+        if (error.Fail()) {
+            return std::nullopt;
+        }
+        return result;
+    }
+
+    /**
+     * @brief 解析 Array<T> 视图：底层 RawArray、起始下标和长度
+     * @param length_override ArrayList 的有效长度（Array 容量可能更大）
+     */
+    std::optional<CangjieFormatters::Sequence> ResolveArray(lldb::SBValue& array,
+                                                            std::optional<uint64_t> length_override) {
+        lldb::SBValue raw = Member(array, {"rawptr", "myData", "data"});
+        const std::optional<uint64_t> length = length_override ? length_override
+                                                                : UnsignedMember(array, {"len", "length", "size"});
+        if (!raw.IsValid() || !length.has_value()) {
+            return std::nullopt;
+        }
+        const uint64_t start = UnsignedMember(array, {"start", "offset"}).value_or(0);
+
+        CangjieFormatters::Sequence sequence;
+        sequence.length = *length;
+        if (sequence.length == 0) {
+            return sequence;
+        }
+
+        // 通过底层数组的第 start 个元素取得基址和元素类型，再用下一个元素校验元素间距
+        lldb::SBValue first = raw.GetChildAtIndex(static_cast<uint32_t>(start));
+        if (!first.IsValid() || first.GetLoadAddress() == LLDB_INVALID_ADDRESS) {
+            return std::nullopt;
+        }
+        sequence.base = first.GetLoadAddress();
+        sequence.element_type = first.GetType();
+        sequence.stride = static_cast<uint32_t>(first.GetByteSize());
+        if (sequence.stride == 0) {
+            return std::nullopt;
+        }
+        if (sequence.length > 1) {
+            lldb::SBValue second = raw.GetChildAtIndex(static_cast<uint32_t>(start + 1));
+            if (!second.IsValid() || second.GetLoadAddress() != sequence.base + sequence.stride) {
+                return std::nullopt;
+            }
+        }
+        return sequence;
+    }
+
+    void AppendEscaped(std::string& out, const uint8_t* data, size_t size) {
+        static const char HEX[] = "0123456789abcdef";
+        for (size_t i = 0; i < size; ++i) {
+            const uint8_t c = data[i];
+            switch (c) {
+                case '"': out += "\\\""; break;
+                case '\\': out += "\\\\"; break;
+                case '\n': out += "\\n"; break;
+                case '\r': out += "\\r"; break;
+                case '\t': out += "\\t"; break;
+                default:
+                    if (c < 0x20 || c == 0x7F) {
+                        out += "\\x";
+                        out += HEX[c >> 4];
+                        out += HEX[c & 0x0F];
+                    } else {
+                        out += static_cast<char>(c);
+                    }
+                    break;
+            }
+        }
+    }
+
+    /**
+     * @brief 截断位置落在多字节 UTF-8 字符中间时，退回到该字符之前
+     */
+    size_t TrimIncompleteUtf8(const uint8_t* data, size_t size) {
+        size_t lead = size;
+        while (lead > 0 && (data[lead - 1] & 0xC0) == 0x80) {
+            --lead;
+        }
+        if (lead == 0) {
+            return size;
+        }
+        const uint8_t c = data[lead - 1];
+        const size_t expected = (c & 0xE0) == 0xC0 ? 2 : (c & 0xF0) == 0xE0 ? 3 : (c & 0xF8) == 0xF0 ? 4 : 1;
+        return size - (lead - 1) >= expected ? size : lead - 1;
+    }
+
+    std::optional<std::string> SummarizeString(lldb::SBValue& value, lldb::SBProcess& process, uint32_t max_length) {
+        lldb::SBValue data = Member(value, {"myData", "data"});
+        const std::optional<uint64_t> length = UnsignedMember(value, {"length", "len", "size"});
+        if (!data.IsValid() || !length.has_value()) {
+            return std::nullopt;
+        }
+        if (*length == 0) {
+            return std::string("\"\"");
+        }
+        const uint64_t start = UnsignedMember(value, {"start", "offset"}).value_or(0);
+
+        lldb::SBValue first = data.GetChildAtIndex(static_cast<uint32_t>(start));
+        if (!first.IsValid() || first.GetByteSize() != 1 || first.GetLoadAddress() == LLDB_INVALID_ADDRESS) {
+            return std::nullopt;
+        }
+
+        const size_t to_read = static_cast<size_t>(std::min<uint64_t>(*length, max_length));
+        std::vector<uint8_t> bytes(to_read);
+        lldb::SBError error;
+        const size_t bytes_read = process.ReadMemory(first.GetLoadAddress(), bytes.data(), to_read, error);
+        if (error.Fail() || bytes_read != to_read) {
+            return std::nullopt;
+        }
+
+        const bool truncated = to_read < *length;
+        const size_t shown = truncated ? TrimIncompleteUtf8(bytes.data(), to_read) : to_read;
+        std::string summary = "\"";
+        AppendEscaped(summary, bytes.data(), shown);
+        summary += truncated ? "\"..." : "\"";
+        return summary;
+    }
+
+    std::optional<std::string> SummarizeSequence(lldb::SBValue& value, lldb::SBProcess& process, uint32_t max_length) {
+        const std::optional<CangjieFormatters::Sequence> sequence = CangjieFormatters::ResolveSequence(value);
+        if (!sequence.has_value()) {
+            return std::nullopt;
+        }
+
+        std::string summary = "size=" + std::to_string(sequence->length);
+        const std::optional<PrimitiveLayout> layout = PrimitiveArrayDecoder::ClassifyType(sequence->element_type);
+        if (!layout.has_value() || sequence->length == 0) {
+            return summary;
+        }
+
+        // 基本类型元素：一次读取有界前缀并在本地解码
+        const uint64_t shown = std::min(sequence->length, SUMMARY_MAX_ELEMENTS);
+        std::vector<uint8_t> buffer(static_cast<size_t>(shown) * layout->byte_size);
+        lldb::SBError error;
+        const size_t bytes_read = process.ReadMemory(sequence->base, buffer.data(), buffer.size(), error);
+        std::vector<std::string> elements;
+        const bool swap_bytes = process.GetByteOrder() != PrimitiveArrayDecoder::HostByteOrder();
+        if (error.Fail() || bytes_read != buffer.size() ||
+            !PrimitiveArrayDecoder::Decode(*layout, swap_bytes, buffer.data(), static_cast<size_t>(shown),
+                                           &elements)) {
+            return summary;
+        }
+
+        summary += " [";
+        bool complete = shown == sequence->length;
+        for (size_t i = 0; i < elements.size(); ++i) {
+            if (summary.size() + elements[i].size() + 2 > max_length) {
+                complete = false;
+                break;
+            }
+            summary += i > 0 ? ", " : "";
+            summary += elements[i];
+        }
+        if (!complete) {
+            summary += summary.back() == '[' ? "..." : ", ...";
+        }
+        summary += "]";
+        return summary;
+    }
+}
+
+CangjieFormatters::Kind CangjieFormatters::Classify(const char* type_name) {
+    if (type_name == nullptr) {
+        return Kind::NONE;
+    }
+    const std::string name = BaseTypeName(type_name);
+    if (name == "String") {
+        return Kind::STRING;
+    }
+    if (name == "Array") {
+        return Kind::ARRAY;
+    }
+    if (name == "ArrayList") {
+        return Kind::ARRAY_LIST;
+    }
+    if (name == "HashMap") {
+        return Kind::HASH_MAP;
+    }
+    return Kind::NONE;
+}
+
+std::optional<CangjieFormatters::Sequence> CangjieFormatters::ResolveSequence(lldb::SBValue& value) {
+    switch (Classify(value.GetTypeName())) {
+        case Kind::ARRAY:
+            return ResolveArray(value, std::nullopt);
+        case Kind::ARRAY_LIST: {
+            lldb::SBValue array = Member(value, {"myData", "data"});
+            const std::optional<uint64_t> size = UnsignedMember(value, {"mySize", "size"});
+            if (!array.IsValid() || !size.has_value()) {
+                return std::nullopt;
+            }
+            return ResolveArray(array, size);
+        }
+        default:
+            return std::nullopt;
+    }
+}
+
+std::optional<std::string> CangjieFormatters::Summarize(lldb::SBValue& value, lldb::SBProcess& process,
+                                                        uint32_t max_length) {
+    const Kind kind = Classify(value.GetTypeName());
+    switch (kind) {
+        case Kind::STRING:
+            return SummarizeString(value, process, max_length);
+        case Kind::ARRAY:
+        case Kind::ARRAY_LIST:
+            return SummarizeSequence(value, process, max_length);
+        case Kind::HASH_MAP: {
+            const std::optional<uint64_t> size = UnsignedMember(value, {"itemCount", "mySize", "size"});
+            if (!size.has_value()) {
+                return std::nullopt;
+            }
+            return "size=" + std::to_string(*size);
+        }
+        default:
+            return std::nullopt;
+    }
+}
+
+} // namespace Cangjie::Debugger
@@ -0,0 +1,644 @@
+/*
+ * Copyright 2025 LinQingYing. and contributors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * The use of this source code is governed by the Apache License 2.0,
+ * which allows users to freely use, modify, and distribute the code,
+ * provided they adhere to the terms of the license.
+ *
+ * The software is provided "as-is", and the authors are not responsible for
+ * any damages or issues arising from its use.
+ *
+ */
+
+#include "cangjie/debugger/ConditionCompiler.h"
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+namespace Cangjie::Debugger {
+
+namespace {
+
+// 括号和 '!' 的嵌套上限，防止异常输入导致递归过深
+constexpr uint32_t MAX_NESTING = 64;
+
+bool IsSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+bool IsDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+bool IsHexDigit(char c) {
+    return IsDigit(c) || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+}
+
+// 非 ASCII 字节按标识符字符处理，与 VariablePathParser 一致
+bool IsIdentifierChar(char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_' || IsDigit(c) ||
+        static_cast<unsigned char>(c) >= 0x80;
+}
+
+// 操作数文本在这些字符处结束，由上层语法继续识别运算符或括号
+bool IsOperandTerminator(char c) {
+    return c == '=' || c == '!' || c == '<' || c == '>' || c == '&' || c == '|' || c == '(' || c == ')';
+}
+
+ConditionScalar MakeBool(bool value) {
+    ConditionScalar scalar;
+    scalar.encoding = PrimitiveEncoding::BOOL;
+    scalar.unsigned_value = value ? 1 : 0;
+    return scalar;
+}
+
+bool IsTruthy(const ConditionScalar& scalar) {
+    switch (scalar.encoding) {
+        case PrimitiveEncoding::SIGNED:
+            return scalar.signed_value != 0;
+        case PrimitiveEncoding::FLOAT:
+            return scalar.float_value != 0.0;
+        default:
+            return scalar.unsigned_value != 0;
+    }
+}
+
+double AsDouble(const ConditionScalar& scalar) {
+    switch (scalar.encoding) {
+        case PrimitiveEncoding::SIGNED:
+            return static_cast<double>(scalar.signed_value);
+        case PrimitiveEncoding::FLOAT:
+            return scalar.float_value;
+        default:
+            return static_cast<double>(scalar.unsigned_value);
+    }
+}
+
+template <typename T>
+bool Apply(ConditionComparison comparison, T lhs, T rhs) {
+    switch (comparison) {
+        case ConditionComparison::EQ:
+            return lhs == rhs;
+        case ConditionComparison::NE:
+            return lhs != rhs;
+        case ConditionComparison::LT:
+            return lhs < rhs;
+        case ConditionComparison::LE:
+            return lhs <= rhs;
+        case ConditionComparison::GT:
+            return lhs > rhs;
+        case ConditionComparison::GE:
+            return lhs >= rhs;
+    }
+    return false;
+}
+
+/**
+ * @brief 按数学值比较两个标量：任一侧为浮点时按 double 比较，有符号负数小于任何无符号数
+ */
+bool CompareScalars(const ConditionScalar& lhs, const ConditionScalar& rhs, ConditionComparison comparison) {
+    if (lhs.encoding == PrimitiveEncoding::FLOAT || rhs.encoding == PrimitiveEncoding::FLOAT) {
+        return Apply(comparison, AsDouble(lhs), AsDouble(rhs));
+    }
+    const bool lhs_signed = lhs.encoding == PrimitiveEncoding::SIGNED;
+    const bool rhs_signed = rhs.encoding == PrimitiveEncoding::SIGNED;
+    if (lhs_signed && rhs_signed) {
+        return Apply(comparison, lhs.signed_value, rhs.signed_value);
+    }
+    const bool lhs_negative = lhs_signed && lhs.signed_value < 0;
+    const bool rhs_negative = rhs_signed && rhs.signed_value < 0;
+    if (lhs_negative != rhs_negative) {
+        return lhs_negative ? Apply(comparison, 0, 1) : Apply(comparison, 1, 0);
+    }
+    const uint64_t lhs_value = lhs_signed ? static_cast<uint64_t>(lhs.signed_value) : lhs.unsigned_value;
+    const uint64_t rhs_value = rhs_signed ? static_cast<uint64_t>(rhs.signed_value) : rhs.unsigned_value;
+    return Apply(comparison, lhs_value, rhs_value);
+}
+
+template <typename T>
+T FromBytes(const uint8_t* raw) {
+    T value;
+    std::memcpy(&value, raw, sizeof(T));
+    return value;
+}
+
+/**
+ * @brief 将主机字节序的原始数据按布局解码为标量
+ */
+bool DecodeScalar(const PrimitiveLayout& layout, const uint8_t* raw, ConditionScalar& out) {
+    out = ConditionScalar();
+    out.encoding = layout.encoding;
+    switch (layout.encoding) {
+        case PrimitiveEncoding::BOOL:
+            out.unsigned_value = std::any_of(raw, raw + layout.byte_size, [](uint8_t b) { return b != 0; }) ? 1 : 0;
+            return true;
+        case PrimitiveEncoding::UNSIGNED:
+            switch (layout.byte_size) {
+                case 1: out.unsigned_value = FromBytes<uint8_t>(raw); return true;
+                case 2: out.unsigned_value = FromBytes<uint16_t>(raw); return true;
+                case 4: out.unsigned_value = FromBytes<uint32_t>(raw); return true;
+                case 8: out.unsigned_value = FromBytes<uint64_t>(raw); return true;
+                default: return false;
+            }
+        case PrimitiveEncoding::SIGNED:
+            switch (layout.byte_size) {
+                case 1: out.signed_value = FromBytes<int8_t>(raw); return true;
+                case 2: out.signed_value = FromBytes<int16_t>(raw); return true;
+                case 4: out.signed_value = FromBytes<int32_t>(raw); return true;
+                case 8: out.signed_value = FromBytes<int64_t>(raw); return true;
+                default: return false;
+            }
+        case PrimitiveEncoding::FLOAT:
+            switch (layout.byte_size) {
+                case 4: out.float_value = FromBytes<float>(raw); return true;
+                case 8: out.float_value = FromBytes<double>(raw); return true;
+                default: return false;
+            }
+    }
+    return false;
+}
+
+/**
+ * @brief 递归下降编译器
+ *
+ * 语法：
+ *   or         := and ('||' and)*
+ *   and        := unary ('&&' unary)*
+ *   unary      := '!' negated | '(' or ')' | comparison
+ *   negated    := '!' negated | '(' or ')' | operand
+ *   comparison := operand (比较运算符 operand)?
+ *
+ * 与仓颉一致，'!' 的优先级高于比较运算符："!a == b" 是 "(!a) == b"。
+ * 对整数而言这是按位取反，不在支持范围内，因此 '!' 之后紧跟比较时编译失败。
+ */
+class Compiler {
+public:
+    Compiler(const std::string& text, std::vector<ConditionInstruction>& code,
+             std::vector<VariablePath>& variables, std::vector<std::string>& registers,
+             std::vector<ConditionScalar>& constants)
+        : text_(text), code_(code), variables_(variables), registers_(registers), constants_(constants) {
+    }
+
+    bool Run() {
+        if (!ParseOr()) {
+            return false;
+        }
+        SkipSpaces();
+        return AtEnd() && depth_ == 1;
+    }
+
+private:
+    void SkipSpaces() {
+        while (!AtEnd() && IsSpace(text_[pos_])) {
+            ++pos_;
+        }
+    }
+
+    [[nodiscard]] bool AtEnd() const {
+        return pos_ >= text_.size();
+    }
+
+    [[nodiscard]] char Peek(size_t ahead = 0) const {
+        return pos_ + ahead < text_.size() ? text_[pos_ + ahead] : '\0';
+    }
+
+    bool Match(const char* token) {
+        SkipSpaces();
+        const size_t length = std::strlen(token);
+        if (text_.compare(pos_, length, token) != 0) {
+            return false;
+        }
+        pos_ += length;
+        return true;
+    }
+
+    size_t Emit(ConditionOpcode opcode, uint32_t operand = 0) {
+        code_.push_back({opcode, operand});
+        return code_.size() - 1;
+    }
+
+    bool Push() {
+        return ++depth_ <= ConditionCompiler::MAX_STACK_DEPTH;
+    }
+
+    bool ParseOr() {
+        if (!ParseAnd()) {
+            return false;
+        }
+        std::vector<size_t> exits;
+        while (Match("||")) {
+            // 左侧为真时短路，栈顶的 true 即为结果；否则弹出后继续求值右侧
+            exits.push_back(Emit(ConditionOpcode::JUMP_IF_TRUE));
+            --depth_;
+            if (!ParseAnd()) {
+                return false;
+            }
+        }
+        for (size_t exit : exits) {
+            code_[exit].operand = static_cast<uint32_t>(code_.size());
+        }
+        return true;
+    }
+
+    bool ParseAnd() {
+        if (!ParseUnary(true)) {
+            return false;
+        }
+        std::vector<size_t> exits;
+        while (Match("&&")) {
+            exits.push_back(Emit(ConditionOpcode::JUMP_IF_FALSE));
+            --depth_;
+            if (!ParseUnary(true)) {
+                return false;
+            }
+        }
+        for (size_t exit : exits) {
+            code_[exit].operand = static_cast<uint32_t>(code_.size());
+        }
+        return true;
+    }
+
+    /**
+     * @param allow_comparison 为 false 时解析 '!' 的操作对象，只接受单个操作数，不接受比较式
+     */
+    bool ParseUnary(bool allow_comparison) {
+        if (++nesting_ > MAX_NESTING) {
+            return false;
+        }
+        bool ok = false;
+        SkipSpaces();
+        if (Peek() == '!' && Peek(1) != '=') {
+            ++pos_;
+            ok = ParseUnary(false);
+            if (ok) {
+                Emit(ConditionOpcode::NOT);
+            }
+        } else if (Peek() == '(') {
+            ++pos_;
+            ok = ParseOr() && Match(")");
+        } else if (allow_comparison) {
+            ok = ParseComparison();
+        } else {
+            ok = ParseOperand() && !LastIsNonBoolConstant();
+        }
+        --nesting_;
+        return ok;
+    }
+
+    bool ParseComparison() {
+        if (!ParseOperand()) {
+            return false;
+        }
+        const std::optional<ConditionComparison> comparison = MatchComparison();
+        if (!comparison.has_value()) {
+            // 仓颉条件必须是 Bool；非 Bool 常量直接交给表达式引擎报告类型错误
+            if (LastIsNonBoolConstant()) {
+                return false;
+            }
+            Emit(ConditionOpcode::TEST);
+            return true;
+        }
+        if (!ParseOperand()) {
+            return false;
+        }
+        Emit(ConditionOpcode::COMPARE, static_cast<uint32_t>(*comparison));
+        --depth_;
+        return true;
+    }
+
+    std::optional<ConditionComparison> MatchComparison() {
+        if (Match("==")) {
+            return ConditionComparison::EQ;
+        }
+        if (Match("!=")) {
+            return ConditionComparison::NE;
+        }
+        if (Match("<=")) {
+            return ConditionComparison::LE;
+        }
+        if (Match(">=")) {
+            return ConditionComparison::GE;
+        }
+        if (Match("<")) {
+            return ConditionComparison::LT;
+        }
+        if (Match(">")) {
+            return ConditionComparison::GT;
+        }
+        return std::nullopt;
+    }
+
+    bool ParseOperand() {
+        SkipSpaces();
+        const char c = Peek();
+        if (IsDigit(c) || (c == '-' && IsDigit(Peek(1)))) {
+            return ParseNumber();
+        }
+        if (c == '$') {
+            return ParseRegister();
+        }
+
+        // 变量路径：取到下一个运算符或括号为止，"->" 属于路径本身
+        const size_t start = pos_;
+        while (!AtEnd()) {
+            if (Peek() == '-' && Peek(1) == '>') {
+                pos_ += 2;
+                continue;
+            }
+            if (IsOperandTerminator(Peek())) {
+                break;
+            }
+            ++pos_;
+        }
+        std::string operand = text_.substr(start, pos_ - start);
+        while (!operand.empty() && IsSpace(operand.back())) {
+            operand.pop_back();
+        }
+        if (operand == "true" || operand == "false") {
+            return AddConstant(MakeBool(operand == "true"));
+        }
+
+        std::optional<VariablePath> path = VariablePathParser::Parse(operand);
+        if (!path.has_value() || !Push()) {
+            return false;
+        }
+        variables_.push_back(std::move(*path));
+        Emit(ConditionOpcode::LOAD_VARIABLE, static_cast<uint32_t>(variables_.size() - 1));
+        return true;
+    }
+
+    bool ParseRegister() {
+        ++pos_;
+        const size_t start = pos_;
+        while (!AtEnd() && IsIdentifierChar(Peek())) {
+            ++pos_;
+        }
+        if (pos_ == start || !Push()) {
+            return false;
+        }
+        registers_.push_back(text_.substr(start, pos_ - start));
+        Emit(ConditionOpcode::LOAD_REGISTER, static_cast<uint32_t>(registers_.size() - 1));
+        return true;
+    }
+
+    /**
+     * @brief 解析数值常量：十进制或 0x 十六进制整数、十进制浮点，允许 '_' 分隔和仓颉类型后缀
+     */
+    bool ParseNumber() {
+        const bool negative = Peek() == '-';
+        if (negative) {
+            ++pos_;
+        }
+
+        std::string digits;
+        bool hex = false;
+        bool is_float = false;
+        auto read_digits = [this, &digits](bool allow_hex) {
+            while (!AtEnd() && ((allow_hex ? IsHexDigit(Peek()) : IsDigit(Peek())) || Peek() == '_')) {
+                if (Peek() != '_') {
+                    digits.push_back(Peek());
+                }
+                ++pos_;
+            }
+        };
+
+        if (Peek() == '0' && (Peek(1) == 'x' || Peek(1) == 'X')) {
+            hex = true;
+            pos_ += 2;
+            read_digits(true);
+        } else {
+            read_digits(false);
+            if (Peek() == '.' && IsDigit(Peek(1))) {
+                is_float = true;
+                digits.push_back('.');
+                ++pos_;
+                read_digits(false);
+            }
+            if (Peek() == 'e' || Peek() == 'E') {
+                is_float = true;
+                digits.push_back('e');
+                ++pos_;
+                if (Peek() == '+' || Peek() == '-') {
+                    digits.push_back(Peek());
+                    ++pos_;
+                }
+                if (!IsDigit(Peek())) {
+                    return false;
+                }
+                read_digits(false);
+            }
+        }
+        if (digits.empty()) {
+            return false;
+        }
+
+        // 类型后缀：i8..i64、u8..u64、f16..f64
+        char suffix = '\0';
+        if (Peek() == 'i' || Peek() == 'u' || Peek() == 'f') {
+            suffix = Peek();
+            ++pos_;
+            const size_t start = pos_;
+            while (IsDigit(Peek())) {
+                ++pos_;
+            }
+            const std::string width = text_.substr(start, pos_ - start);
+            const bool valid = suffix == 'f' ? (width == "16" || width == "32" || width == "64")
+                                             : (width == "8" || width == "16" || width == "32" || width == "64");
+            if (!valid || (suffix == 'f' && hex) || (suffix != 'f' && is_float)) {
+                return false;
+            }
+            is_float = suffix == 'f';
+        }
+        if (IsIdentifierChar(Peek()) || Peek() == '.') {
+            return false;
+        }
+
+        ConditionScalar scalar;
+        errno = 0;
+        if (is_float) {
+            scalar.encoding = PrimitiveEncoding::FLOAT;
+            scalar.float_value = std::strtod(digits.c_str(), nullptr);
+            if (negative) {
+                scalar.float_value = -scalar.float_value;
+            }
+            return errno == 0 && AddConstant(scalar);
+        }
+
+        const unsigned long long magnitude = std::strtoull(digits.c_str(), nullptr, hex ? 16 : 10);
+        if (errno != 0) {
+            return false;
+        }
+        constexpr uint64_t SIGNED_MAX = static_cast<uint64_t>(std::numeric_limits<int64_t>::max());
+        if (negative) {
+            if (suffix == 'u' || magnitude > SIGNED_MAX + 1) {
+                return false;
+            }
+            scalar.encoding = PrimitiveEncoding::SIGNED;
+            scalar.signed_value = magnitude == SIGNED_MAX + 1 ? std::numeric_limits<int64_t>::min()
+                                                              : -static_cast<int64_t>(magnitude);
+        } else if (suffix == 'u' || magnitude > SIGNED_MAX) {
+            if (suffix == 'i') {
+                return false;
+            }
+            scalar.encoding = PrimitiveEncoding::UNSIGNED;
+            scalar.unsigned_value = magnitude;
+        } else {
+            scalar.encoding = PrimitiveEncoding::SIGNED;
+            scalar.signed_value = static_cast<int64_t>(magnitude);
+        }
+        return AddConstant(scalar);
+    }
+
+    [[nodiscard]] bool LastIsNonBoolConstant() const {
+        return !code_.empty() && code_.back().opcode == ConditionOpcode::LOAD_CONSTANT &&
+            constants_[code_.back().operand].encoding != PrimitiveEncoding::BOOL;
+    }
+
+    bool AddConstant(const ConditionScalar& scalar) {
+        if (!Push()) {
+            return false;
+        }
+        constants_.push_back(scalar);
+        Emit(ConditionOpcode::LOAD_CONSTANT, static_cast<uint32_t>(constants_.size() - 1));
+        return true;
+    }
+
+    const std::string& text_;
+    size_t pos_ = 0;
+    uint32_t depth_ = 0;
+    uint32_t nesting_ = 0;
+    std::vector<ConditionInstruction>& code_;
+    std::vector<VariablePath>& variables_;
+    std::vector<std::string>& registers_;
+    std::vector<ConditionScalar>& constants_;
+};
+
+} // namespace
+
+std::optional<ConditionProgram> ConditionCompiler::Compile(const std::string& condition) {
+    ConditionProgram program;
+    program.source_ = condition;
+    Compiler compiler(condition, program.code_, program.variables_, program.registers_, program.constants_);
+    if (!compiler.Run()) {
+        return std::nullopt;
+    }
+    return program;
+}
+
+std::optional<bool> ConditionProgram::Evaluate(lldb::SBProcess& process, lldb::SBFrame& frame) const {
+    if (!frame.IsValid()) {
+        return std::nullopt;
+    }
+
+    std::array<ConditionScalar, ConditionCompiler::MAX_STACK_DEPTH> stack;
+    size_t top = 0;
+    size_t pc = 0;
+    while (pc < code_.size()) {
+        const ConditionInstruction& instruction = code_[pc++];
+        switch (instruction.opcode) {
+            case ConditionOpcode::LOAD_VARIABLE: {
+                const VariablePath& path = variables_[instruction.operand];
+                lldb::SBValue value = path.is_identifier ? frame.FindVariable(path.root.c_str())
+                                                         : frame.GetValueForVariablePath(path.path.c_str());
+                if (!LoadValue(process, value, stack[top++])) {
+                    return std::nullopt;
+                }
+                break;
+            }
+            case ConditionOpcode::LOAD_REGISTER:
+                if (!LoadValue(process, frame.FindRegister(registers_[instruction.operand].c_str()), stack[top++])) {
+                    return std::nullopt;
+                }
+                break;
+            case ConditionOpcode::LOAD_CONSTANT:
+                stack[top++] = constants_[instruction.operand];
+                break;
+            case ConditionOpcode::COMPARE:
+                --top;
+                stack[top - 1] = MakeBool(CompareScalars(stack[top - 1], stack[top],
+                                                         static_cast<ConditionComparison>(instruction.operand)));
+                break;
+            case ConditionOpcode::TEST:
+            case ConditionOpcode::NOT:
+                // 仓颉中非 Bool 条件是类型错误，整数上的 '!' 是按位取反，均交给表达式引擎
+                if (stack[top - 1].encoding != PrimitiveEncoding::BOOL) {
+                    return std::nullopt;
+                }
+                if (instruction.opcode == ConditionOpcode::NOT) {
+                    stack[top - 1] = MakeBool(stack[top - 1].unsigned_value == 0);
+                }
+                break;
+            case ConditionOpcode::JUMP_IF_FALSE:
+                if (!IsTruthy(stack[top - 1])) {
+                    pc = instruction.operand;
+                } else {
+                    --top;
+                }
+                break;
+            case ConditionOpcode::JUMP_IF_TRUE:
+                if (IsTruthy(stack[top - 1])) {
+                    pc = instruction.operand;
+                } else {
+                    --top;
+                }
+                break;
+        }
+    }
+    if (top != 1) {
+        return std::nullopt;
+    }
+    return IsTruthy(stack[0]);
+}
+
+bool ConditionProgram::LoadValue(lldb::SBProcess& process, lldb::SBValue value, ConditionScalar& out) const {
+    if (!value.IsValid() || value.GetError().Fail()) {
+        return false;
+    }
+    const std::optional<PrimitiveLayout> layout = PrimitiveArrayDecoder::ClassifyType(value.GetType());
+    if (!layout.has_value()) {
+        return false;
+    }
+
+    uint8_t raw[sizeof(uint64_t)] = {};
+    lldb::SBError error;
+    lldb::ByteOrder byte_order;
+    const lldb::addr_t address = value.GetLoadAddress();
+    if (address != LLDB_INVALID_ADDRESS) {
+        // 位于内存中的变量：按类型宽度直接读取，不经过值格式化
+        const size_t bytes_read = process.ReadMemory(address, raw, layout->byte_size, error);
+        if (error.Fail() || bytes_read != layout->byte_size) {
+            return false;
+        }
+        byte_order = process.GetByteOrder();
+    } else {
+        // 寄存器或保存在寄存器中的变量：使用 LLDB 已读出的原始数据
+        lldb::SBData data = value.GetData();
+        const size_t bytes_read = data.ReadRawData(error, 0, raw, layout->byte_size);
+        if (error.Fail() || bytes_read != layout->byte_size) {
+            return false;
+        }
+        byte_order = data.GetByteOrder();
+    }
+    if (byte_order != PrimitiveArrayDecoder::HostByteOrder()) {
+        std::reverse(raw, raw + layout->byte_size);
+    }
+    return DecodeScalar(*layout, raw, out);
+}
+
+} // namespace Cangjie::Debugger
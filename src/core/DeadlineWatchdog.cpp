@@ -0,0 +1,98 @@
+/*
+ * Copyright 2025 LinQingYing. and contributors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * The use of this source code is governed by the Apache License 2.0,
+ * which allows users to freely use, modify, and distribute the code,
+ * provided they adhere to the terms of the license.
+ *
+ * The software is provided "as-is", and the authors are not responsible for
+ * any damages or issues arising from its use.
+ *
+ */
+
+#include "cangjie/debugger/DeadlineWatchdog.h"
+
+#include <utility>
+
+namespace Cangjie::Debugger {
+
+DeadlineWatchdog::~DeadlineWatchdog() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    cv_.notify_all();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+uint64_t DeadlineWatchdog::Arm(std::chrono::milliseconds timeout, std::function<void()> on_expired) {
+    uint64_t ticket;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ticket = ++next_ticket_;
+        armed_ticket_ = ticket;
+        deadline_ = std::chrono::steady_clock::now() + timeout;
+        on_expired_ = std::move(on_expired);
+        if (!thread_.joinable()) {
+            thread_ = std::thread(&DeadlineWatchdog::Loop, this);
+        }
+    }
+    cv_.notify_all();
+    return ticket;
+}
+
+void DeadlineWatchdog::Disarm(uint64_t ticket) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (armed_ticket_ == ticket) {
+        armed_ticket_ = 0;
+        on_expired_ = nullptr;
+    }
+}
+
+bool DeadlineWatchdog::HasExpired(uint64_t ticket) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return expired_ticket_ == ticket;
+}
+
+void DeadlineWatchdog::Loop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stopping_) {
+        if (armed_ticket_ == 0) {
+            cv_.wait(lock);
+            continue;
+        }
+        if (cv_.wait_until(lock, deadline_) != std::cv_status::timeout) {
+            continue;
+        }
+        if (armed_ticket_ == 0 || std::chrono::steady_clock::now() < deadline_) {
+            continue;
+        }
+
+        // 在锁外执行回调，回调期间允许 Disarm/Arm
+        expired_ticket_ = armed_ticket_;
+        armed_ticket_ = 0;
+        std::function<void()> callback = std::move(on_expired_);
+        on_expired_ = nullptr;
+        lock.unlock();
+        if (callback) {
+            callback();
+        }
+        lock.lock();
+    }
+}
+
+} // namespace Cangjie::Debugger
@@ -0,0 +1,137 @@
+/*
+ * Copyright 2025 LinQingYing. and contributors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * The use of this source code is governed by the Apache License 2.0,
+ * which allows users to freely use, modify, and distribute the code,
+ * provided they adhere to the terms of the license.
+ *
+ * The software is provided "as-is", and the authors are not responsible for
+ * any damages or issues arising from its use.
+ *
+ */
+
+#include "cangjie/debugger/LexicalScopeCache.h"
+
+#include <cstring>
+
+namespace Cangjie::Debugger {
+
+bool LexicalScopeCache::Visibility::IsVisible(const char* name, uint32_t decl_line) const {
+    if (!scopes_ || name == nullptr) {
+        return true;
+    }
+    auto it = scopes_->declarations.find(decl_line);
+    if (it == scopes_->declarations.end()) {
+        return true;
+    }
+    for (const Declaration& declaration : it->second) {
+        if (std::strcmp(declaration.name.c_str(), name) == 0) {
+            return active_blocks_[declaration.block];
+        }
+    }
+    return true;
+}
+
+LexicalScopeCache::Visibility LexicalScopeCache::Resolve(lldb::SBFunction function, lldb::addr_t pc,
+                                                         lldb::SBTarget& target) {
+    Visibility visibility;
+    if (!function.IsValid() || pc == LLDB_INVALID_ADDRESS) {
+        return visibility;
+    }
+    const lldb::addr_t key = function.GetStartAddress().GetLoadAddress(target);
+    if (key == LLDB_INVALID_ADDRESS) {
+        return visibility;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = functions_.find(key);
+        if (it != functions_.end()) {
+            visibility.scopes_ = it->second;
+        }
+    }
+    if (!visibility.scopes_) {
+        // 在锁外遍历块树，LLDB 查询可能较慢；并发构建同一函数时保留先写入的结果
+        std::shared_ptr<const FunctionScopes> built = Build(function, target);
+        std::lock_guard<std::mutex> lock(mutex_);
+        visibility.scopes_ = functions_.emplace(key, std::move(built)).first->second;
+    }
+
+    const auto& block_ranges = visibility.scopes_->block_ranges;
+    visibility.active_blocks_.resize(block_ranges.size(), false);
+    for (size_t i = 0; i < block_ranges.size(); ++i) {
+        for (const auto& [start, end] : block_ranges[i]) {
+            if (pc >= start && pc < end) {
+                visibility.active_blocks_[i] = true;
+                break;
+            }
+        }
+    }
+    return visibility;
+}
+
+void LexicalScopeCache::Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    functions_.clear();
+}
+
+size_t LexicalScopeCache::Size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return functions_.size();
+}
+
+std::shared_ptr<const LexicalScopeCache::FunctionScopes> LexicalScopeCache::Build(lldb::SBFunction& function,
+                                                                                  lldb::SBTarget& target) {
+    auto scopes = std::make_shared<FunctionScopes>();
+
+    std::vector<lldb::SBBlock> pending;
+    pending.push_back(function.GetBlock());
+    while (!pending.empty()) {
+        lldb::SBBlock block = pending.back();
+        pending.pop_back();
+        if (!block.IsValid()) {
+            continue;
+        }
+
+        const auto index = static_cast<uint32_t>(scopes->block_ranges.size());
+        auto& ranges = scopes->block_ranges.emplace_back();
+        for (uint32_t i = 0; i < block.GetNumRanges(); ++i) {
+            const lldb::addr_t start = block.GetRangeStartAddress(i).GetLoadAddress(target);
+            const lldb::addr_t end = block.GetRangeEndAddress(i).GetLoadAddress(target);
+            if (start != LLDB_INVALID_ADDRESS && end != LLDB_INVALID_ADDRESS) {
+                ranges.emplace_back(start, end);
+            }
+        }
+
+        // 只取本块直接声明的局部变量，子块的变量在遍历到子块时记录
+        lldb::SBValueList locals = block.GetVariables(target, false, true, false);
+        for (uint32_t i = 0; i < locals.GetSize(); ++i) {
+            lldb::SBValue local = locals.GetValueAtIndex(i);
+            const char* name = local.GetName();
+            lldb::SBDeclaration declaration = local.GetDeclaration();
+            if (name == nullptr || !declaration.IsValid()) {
+                continue;
+            }
+            scopes->declarations[declaration.GetLine()].push_back(Declaration{name, index});
+        }
+
+        for (lldb::SBBlock child = block.GetFirstChild(); child.IsValid(); child = child.GetSibling()) {
+            pending.push_back(child);
+        }
+    }
+    return scopes;
+}
+
+} // namespace Cangjie::Debugger
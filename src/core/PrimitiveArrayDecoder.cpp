@@ -0,0 +1,220 @@
+/*
+ * Copyright 2025 LinQingYing. and contributors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * The use of this source code is governed by the Apache License 2.0,
+ * which allows users to freely use, modify, and distribute the code,
+ * provided they adhere to the terms of the license.
+ *
+ * The software is provided "as-is", and the authors are not responsible for
+ * any damages or issues arising from its use.
+ *
+ */
+
+
+#include "cangjie/debugger/PrimitiveArrayDecoder.h"
+
+#include <charconv>
+#include <cstring>
+
+namespace Cangjie::Debugger {
+
+namespace {
+    // 移位形式的字节交换，编译器可识别为 bswap 并向量化
+    inline uint8_t ByteSwap(uint8_t v) { return v; }
+
+    inline uint16_t ByteSwap(uint16_t v) {
+        return static_cast<uint16_t>((v >> 8) | (v << 8));
+    }
+
+    inline uint32_t ByteSwap(uint32_t v) {
+        return ((v & 0x000000FFu) << 24) | ((v & 0x0000FF00u) << 8) |
+               ((v & 0x00FF0000u) >> 8) | ((v & 0xFF000000u) >> 24);
+    }
+
+    inline uint64_t ByteSwap(uint64_t v) {
+        return (static_cast<uint64_t>(ByteSwap(static_cast<uint32_t>(v))) << 32) |
+               ByteSwap(static_cast<uint32_t>(v >> 32));
+    }
+
+    /**
+     * @brief 将 count 个宽度为 sizeof(Raw) 的元素扩展为 Wide
+     *
+     * 字节交换的判断放在循环外，两个循环体都是无分支的定长拷贝。
+     */
+    template <typename Raw, typename Element, typename Wide>
+    void Widen(const uint8_t *data, size_t count, bool swap_bytes, Wide *out) {
+        static_assert(sizeof(Raw) == sizeof(Element), "raw and element width must match");
+        if (swap_bytes) {
+            for (size_t i = 0; i < count; ++i) {
+                Raw raw;
+                std::memcpy(&raw, data + i * sizeof(Raw), sizeof(Raw));
+                raw = ByteSwap(raw);
+                Element element;
+                std::memcpy(&element, &raw, sizeof(Element));
+                out[i] = static_cast<Wide>(element);
+            }
+        } else {
+            for (size_t i = 0; i < count; ++i) {
+                Element element;
+                std::memcpy(&element, data + i * sizeof(Element), sizeof(Element));
+                out[i] = static_cast<Wide>(element);
+            }
+        }
+    }
+
+    template <typename Wide>
+    void FormatIntegers(const std::vector<Wide> &wide, std::vector<std::string> *values) {
+        char buffer[24];
+        for (size_t i = 0; i < wide.size(); ++i) {
+            const auto result = std::to_chars(buffer, buffer + sizeof(buffer), wide[i]);
+            (*values)[i].assign(buffer, result.ptr);
+        }
+    }
+
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+    template <typename Float>
+    void FormatFloats(const std::vector<Float> &wide, std::vector<std::string> *values) {
+        char buffer[32];
+        for (size_t i = 0; i < wide.size(); ++i) {
+            const auto result = std::to_chars(buffer, buffer + sizeof(buffer), wide[i]);
+            (*values)[i].assign(buffer, result.ptr);
+        }
+    }
+#endif
+}
+
+bool PrimitiveArrayDecoder::IsSupported(const PrimitiveLayout &layout) {
+    switch (layout.encoding) {
+        case PrimitiveEncoding::FLOAT:
+            return layout.byte_size == 4 || layout.byte_size == 8;
+        case PrimitiveEncoding::BOOL:
+        case PrimitiveEncoding::SIGNED:
+        case PrimitiveEncoding::UNSIGNED:
+            return layout.byte_size == 1 || layout.byte_size == 2 || layout.byte_size == 4 ||
+                   layout.byte_size == 8;
+    }
+    return false;
+}
+
+std::optional<PrimitiveLayout> PrimitiveArrayDecoder::ClassifyType(lldb::SBType type) {
+    type = type.GetCanonicalType();
+    if (!type.IsValid()) {
+        return std::nullopt;
+    }
+
+    PrimitiveLayout layout;
+    layout.byte_size = static_cast<uint32_t>(type.GetByteSize());
+
+    switch (type.GetBasicType()) {
+        case lldb::eBasicTypeBool:
+            layout.encoding = PrimitiveEncoding::BOOL;
+            return IsSupported(layout) ? std::optional(layout) : std::nullopt;
+        case lldb::eBasicTypeChar:
+        case lldb::eBasicTypeSignedChar:
+        case lldb::eBasicTypeUnsignedChar:
+        case lldb::eBasicTypeWChar:
+        case lldb::eBasicTypeSignedWChar:
+        case lldb::eBasicTypeUnsignedWChar:
+        case lldb::eBasicTypeChar16:
+        case lldb::eBasicTypeChar32:
+        case lldb::eBasicTypeChar8:
+        case lldb::eBasicTypeInvalid:
+            return std::nullopt;
+        default:
+            break;
+    }
+
+    const uint32_t flags = type.GetTypeFlags();
+    if ((flags & lldb::eTypeIsBuiltIn) == 0 || (flags & lldb::eTypeIsScalar) == 0) {
+        return std::nullopt;
+    }
+    if (flags & lldb::eTypeIsFloat) {
+        layout.encoding = PrimitiveEncoding::FLOAT;
+    } else if (flags & lldb::eTypeIsInteger) {
+        layout.encoding = (flags & lldb::eTypeIsSigned) ? PrimitiveEncoding::SIGNED : PrimitiveEncoding::UNSIGNED;
+    } else {
+        return std::nullopt;
+    }
+    return IsSupported(layout) ? std::optional(layout) : std::nullopt;
+}
+
+lldb::ByteOrder PrimitiveArrayDecoder::HostByteOrder() {
+    const uint16_t probe = 1;
+    uint8_t first_byte = 0;
+    std::memcpy(&first_byte, &probe, 1);
+    return first_byte == 1 ? lldb::eByteOrderLittle : lldb::eByteOrderBig;
+}
+
+bool PrimitiveArrayDecoder::Decode(const PrimitiveLayout &layout, bool swap_bytes, const uint8_t *data,
+                                   size_t count, std::vector<std::string> *values) {
+    if (!IsSupported(layout)) {
+        return false;
+    }
+    values->resize(count);
+
+    switch (layout.encoding) {
+        case PrimitiveEncoding::SIGNED: {
+            std::vector<int64_t> wide(count);
+            switch (layout.byte_size) {
+                case 1: Widen<uint8_t, int8_t>(data, count, swap_bytes, wide.data()); break;
+                case 2: Widen<uint16_t, int16_t>(data, count, swap_bytes, wide.data()); break;
+                case 4: Widen<uint32_t, int32_t>(data, count, swap_bytes, wide.data()); break;
+                default: Widen<uint64_t, int64_t>(data, count, swap_bytes, wide.data()); break;
+            }
+            FormatIntegers(wide, values);
+            return true;
+        }
+        case PrimitiveEncoding::UNSIGNED:
+        case PrimitiveEncoding::BOOL: {
+            std::vector<uint64_t> wide(count);
+            switch (layout.byte_size) {
+                case 1: Widen<uint8_t, uint8_t>(data, count, swap_bytes, wide.data()); break;
+                case 2: Widen<uint16_t, uint16_t>(data, count, swap_bytes, wide.data()); break;
+                case 4: Widen<uint32_t, uint32_t>(data, count, swap_bytes, wide.data()); break;
+                default: Widen<uint64_t, uint64_t>(data, count, swap_bytes, wide.data()); break;
+            }
+            if (layout.encoding == PrimitiveEncoding::BOOL) {
+                for (size_t i = 0; i < count; ++i) {
+                    (*values)[i] = wide[i] != 0 ? "true" : "false";
+                }
+            } else {
+                FormatIntegers(wide, values);
+            }
+            return true;
+        }
+        case PrimitiveEncoding::FLOAT: {
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+            // 不指定精度的 to_chars 输出能往返的最短形式，与 LLDB 的默认浮点显示一致；
+            // 单精度按 float 格式化，避免扩展为 double 后多出无意义的尾数
+            if (layout.byte_size == 4) {
+                std::vector<float> wide(count);
+                Widen<uint32_t, float>(data, count, swap_bytes, wide.data());
+                FormatFloats(wide, values);
+            } else {
+                std::vector<double> wide(count);
+                Widen<uint64_t, double>(data, count, swap_bytes, wide.data());
+                FormatFloats(wide, values);
+            }
+            return true;
+#else
+            // 标准库不支持浮点 to_chars 时无法保证与 LLDB 一致，由调用方逐元素读取
+            return false;
+#endif
+        }
+    }
+    return false;
+}
+
+} // namespace Cangjie::Debugger
@@ -0,0 +1,97 @@
+/*
+ * Copyright 2025 LinQingYing. and contributors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * The use of this source code is governed by the Apache License 2.0,
+ * which allows users to freely use, modify, and distribute the code,
+ * provided they adhere to the terms of the license.
+ *
+ * The software is provided "as-is", and the authors are not responsible for
+ * any damages or issues arising from its use.
+ *
+ */
+
+
+#include "cangjie/debugger/StopCache.h"
+#include "cangjie/debugger/Logger.h"
+
+namespace Cangjie::Debugger {
+
+bool StopCache::Lookup(uint32_t stop_id, Kind kind, const std::string& key, google::protobuf::Message* out) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ResetIfStale(stop_id);
+
+    const EntryMap& entries = entries_[static_cast<size_t>(kind)];
+    auto it = entries.find(key);
+    if (it == entries.end() || it->second->GetDescriptor() != out->GetDescriptor()) {
+        ++misses_;
+        return false;
+    }
+
+    out->CopyFrom(*it->second);
+    ++hits_;
+    return true;
+}
+
+void StopCache::Store(uint32_t stop_id, Kind kind, const std::string& key, const google::protobuf::Message& value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ResetIfStale(stop_id);
+
+    std::unique_ptr<google::protobuf::Message> copy(value.New());
+    copy->CopyFrom(value);
+    entries_[static_cast<size_t>(kind)][key] = std::move(copy);
+}
+
+void StopCache::Invalidate() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& entries : entries_) {
+        entries.clear();
+    }
+    valid_ = false;
+}
+
+void StopCache::InvalidateValues() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_[static_cast<size_t>(Kind::VARIABLES)].clear();
+    entries_[static_cast<size_t>(Kind::REGISTERS)].clear();
+    entries_[static_cast<size_t>(Kind::EVALUATIONS)].clear();
+}
+
+uint64_t StopCache::GetHitCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return hits_;
+}
+
+uint64_t StopCache::GetMissCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return misses_;
+}
+
+void StopCache::ResetIfStale(uint32_t stop_id) {
+    if (valid_ && stop_id_ == stop_id) {
+        return;
+    }
+
+    if (valid_) {
+        LOG_INFO("Stop ID changed (" + std::to_string(stop_id_) + " -> " + std::to_string(stop_id) +
+                 "), clearing stop cache");
+    }
+    for (auto& entries : entries_) {
+        entries.clear();
+    }
+    stop_id_ = stop_id;
+    valid_ = true;
+}
+
+} // namespace Cangjie::Debugger
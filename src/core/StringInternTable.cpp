@@ -0,0 +1,59 @@
+/*
+ * Copyright 2025 LinQingYing. and contributors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * The use of this source code is governed by the Apache License 2.0,
+ * which allows users to freely use, modify, and distribute the code,
+ * provided they adhere to the terms of the license.
+ *
+ * The software is provided "as-is", and the authors are not responsible for
+ * any damages or issues arising from its use.
+ *
+ */
+
+
+#include "cangjie/debugger/StringInternTable.h"
+#include "cangjie/debugger/Logger.h"
+
+namespace Cangjie::Debugger {
+
+uint32_t StringInternTable::Intern(const std::string& value, bool* is_new) {
+    *is_new = false;
+    if (value.size() < MIN_INTERN_LENGTH) {
+        return 0;
+    }
+
+    auto it = ids_.find(value);
+    if (it != ids_.end()) {
+        return it->second;
+    }
+
+    if (ids_.size() >= MAX_ENTRIES) {
+        return 0;
+    }
+
+    const auto id = static_cast<uint32_t>(ids_.size() + 1);
+    ids_.emplace(value, id);
+    if (ids_.size() == MAX_ENTRIES) {
+        LOG_WARNING("String intern table is full, new strings will be sent inline");
+    }
+    *is_new = true;
+    return id;
+}
+
+void StringInternTable::Reset() {
+    ids_.clear();
+}
+
+} // namespace Cangjie::Debugger
@@ -0,0 +1,77 @@
+/*
+ * Copyright 2025 LinQingYing. and contributors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * The use of this source code is governed by the Apache License 2.0,
+ * which allows users to freely use, modify, and distribute the code,
+ * provided they adhere to the terms of the license.
+ *
+ * The software is provided "as-is", and the authors are not responsible for
+ * any damages or issues arising from its use.
+ *
+ */
+
+
+#include "cangjie/debugger/TypeCache.h"
+
+namespace Cangjie::Debugger {
+
+std::string TypeCache::MakeKey(const char* module_uuid, const char* type_name) {
+    std::string key = module_uuid ? module_uuid : "";
+    // 类型名中不会出现 '\0'，用作分隔符避免拼接歧义
+    key.push_back('\0');
+    key.append(type_name ? type_name : "");
+    return key;
+}
+
+bool TypeCache::Lookup(const std::string& key, lldbprotobuf::Type* out) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(key);
+    if (it == entries_.end()) {
+        ++misses_;
+        return false;
+    }
+
+    out->CopyFrom(it->second);
+    ++hits_;
+    return true;
+}
+
+void TypeCache::Store(const std::string& key, const lldbprotobuf::Type& type) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_[key] = type;
+}
+
+void TypeCache::Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+}
+
+uint64_t TypeCache::GetHitCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return hits_;
+}
+
+uint64_t TypeCache::GetMissCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return misses_;
+}
+
+double TypeCache::GetHitRate() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const uint64_t total = hits_ + misses_;
+    return total == 0 ? 0.0 : static_cast<double>(hits_) / static_cast<double>(total);
+}
+
+} // namespace Cangjie::Debugger
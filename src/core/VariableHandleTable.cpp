@@ -0,0 +1,245 @@
+/*
+ * Copyright 2025 LinQingYing. and contributors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * The use of this source code is governed by the Apache License 2.0,
+ * which allows users to freely use, modify, and distribute the code,
+ * provided they adhere to the terms of the license.
+ *
+ * The software is provided "as-is", and the authors are not responsible for
+ * any damages or issues arising from its use.
+ *
+ */
+
+
+#include "cangjie/debugger/VariableHandleTable.h"
+
+#include <utility>
+
+namespace Cangjie::Debugger {
+
+uint64_t VariableHandleTable::MakeHandle(uint32_t slot, uint32_t generation) {
+    return (static_cast<uint64_t>(generation) << 32) | (static_cast<uint64_t>(slot) + 1);
+}
+
+uint64_t VariableHandleTable::Acquire(uint64_t key, VariableOrigin origin, const lldb::SBValue& value) {
+    uint32_t slot_index;
+    auto it = key_index_.find(key);
+    if (it != key_index_.end()) {
+        slot_index = it->second;
+    } else {
+        if (free_head_ != INVALID_SLOT) {
+            slot_index = free_head_;
+            free_head_ = slots_[slot_index].next_free;
+        } else {
+            slot_index = static_cast<uint32_t>(slots_.size());
+            slots_.emplace_back();
+        }
+        Slot& slot = slots_[slot_index];
+        slot.key = key;
+        slot.in_use = true;
+        slot.next_free = INVALID_SLOT;
+        key_index_.emplace(key, slot_index);
+        ++in_use_;
+    }
+
+    Slot& slot = slots_[slot_index];
+    slot.origin = std::move(origin);
+    StoreValue(slot_index, value);
+    EnforceBudget();
+    return MakeHandle(slot_index, slot.generation);
+}
+
+bool VariableHandleTable::Refresh(uint64_t handle, const lldb::SBValue& value) {
+    if (Resolve(handle) == nullptr) {
+        return false;
+    }
+    const auto slot_index = static_cast<uint32_t>((handle & 0xFFFFFFFFULL) - 1);
+    StoreValue(slot_index, value);
+    EnforceBudget();
+    return true;
+}
+
+void VariableHandleTable::StoreValue(uint32_t slot_index, const lldb::SBValue& value) {
+    Slot& slot = slots_[slot_index];
+    slot.value = value;
+    slot.epoch = epoch_;
+    if (!value.IsValid()) {
+        // 仅登记来源的句柄不占用 SBValue 预算
+        if (slot.live) {
+            Unlink(slot_index);
+            slot.live = false;
+            --live_count_;
+        }
+        return;
+    }
+    if (slot.live) {
+        Unlink(slot_index);
+    } else {
+        slot.live = true;
+        ++live_count_;
+    }
+    LinkFront(slot_index);
+}
+
+ValueChange VariableHandleTable::RecordFingerprint(uint64_t handle, uint64_t fingerprint) {
+    if (Resolve(handle) == nullptr) {
+        return ValueChange::UNKNOWN;
+    }
+    Slot& slot = slots_[static_cast<uint32_t>((handle & 0xFFFFFFFFULL) - 1)];
+
+    // 进入新的停止代后第一次记录：把上一次的指纹转为比较基准
+    if (slot.has_fingerprint && slot.fingerprint_epoch != epoch_) {
+        slot.previous_fingerprint = slot.fingerprint;
+        slot.has_previous_fingerprint = true;
+    }
+    slot.fingerprint = fingerprint;
+    slot.fingerprint_epoch = epoch_;
+    slot.has_fingerprint = true;
+
+    if (!slot.has_previous_fingerprint) {
+        return ValueChange::UNKNOWN;
+    }
+    return slot.previous_fingerprint == fingerprint ? ValueChange::UNCHANGED : ValueChange::CHANGED;
+}
+
+const VariableHandleTable::Slot* VariableHandleTable::Resolve(uint64_t handle) const {
+    const uint64_t slot_plus_one = handle & 0xFFFFFFFFULL;
+    if (slot_plus_one == 0 || slot_plus_one > slots_.size()) {
+        return nullptr;
+    }
+    const Slot& slot = slots_[slot_plus_one - 1];
+    if (!slot.in_use || slot.generation != static_cast<uint32_t>(handle >> 32)) {
+        return nullptr;
+    }
+    return &slot;
+}
+
+lldb::SBValue VariableHandleTable::Find(uint64_t handle) {
+    const Slot* slot = Resolve(handle);
+    if (slot == nullptr || !slot->live || slot->epoch != epoch_) {
+        return lldb::SBValue();
+    }
+
+    const auto slot_index = static_cast<uint32_t>((handle & 0xFFFFFFFFULL) - 1);
+    if (lru_head_ != slot_index) {
+        Unlink(slot_index);
+        LinkFront(slot_index);
+    }
+    return slot->value;
+}
+
+const VariableOrigin* VariableHandleTable::FindOrigin(uint64_t handle) const {
+    const Slot* slot = Resolve(handle);
+    return slot != nullptr ? &slot->origin : nullptr;
+}
+
+void VariableHandleTable::BumpEpoch() {
+    ++epoch_;
+}
+
+size_t VariableHandleTable::Clear() {
+    const size_t released = in_use_;
+    for (uint32_t i = 0; i < slots_.size(); ++i) {
+        if (slots_[i].in_use) {
+            Release(i);
+        }
+    }
+    return released;
+}
+
+size_t VariableHandleTable::Size() const {
+    return in_use_;
+}
+
+void VariableHandleTable::SetMaxLiveValues(size_t max_live_values) {
+    max_live_values_ = max_live_values;
+    EnforceBudget();
+}
+
+size_t VariableHandleTable::LiveCount() const {
+    return live_count_;
+}
+
+uint64_t VariableHandleTable::EvictionCount() const {
+    return evictions_;
+}
+
+void VariableHandleTable::LinkFront(uint32_t slot_index) {
+    Slot& slot = slots_[slot_index];
+    slot.lru_prev = INVALID_SLOT;
+    slot.lru_next = lru_head_;
+    if (lru_head_ != INVALID_SLOT) {
+        slots_[lru_head_].lru_prev = slot_index;
+    }
+    lru_head_ = slot_index;
+    if (lru_tail_ == INVALID_SLOT) {
+        lru_tail_ = slot_index;
+    }
+}
+
+void VariableHandleTable::Unlink(uint32_t slot_index) {
+    Slot& slot = slots_[slot_index];
+    if (slot.lru_prev != INVALID_SLOT) {
+        slots_[slot.lru_prev].lru_next = slot.lru_next;
+    } else {
+        lru_head_ = slot.lru_next;
+    }
+    if (slot.lru_next != INVALID_SLOT) {
+        slots_[slot.lru_next].lru_prev = slot.lru_prev;
+    } else {
+        lru_tail_ = slot.lru_prev;
+    }
+    slot.lru_prev = INVALID_SLOT;
+    slot.lru_next = INVALID_SLOT;
+}
+
+void VariableHandleTable::EnforceBudget() {
+    if (max_live_values_ == 0) {
+        return;
+    }
+    while (live_count_ > max_live_values_ && lru_tail_ != INVALID_SLOT) {
+        const uint32_t victim = lru_tail_;
+        Unlink(victim);
+        Slot& slot = slots_[victim];
+        slot.value = lldb::SBValue();
+        slot.live = false;
+        --live_count_;
+        ++evictions_;
+    }
+}
+
+void VariableHandleTable::Release(uint32_t slot_index) {
+    Slot& slot = slots_[slot_index];
+    if (slot.live) {
+        Unlink(slot_index);
+        slot.live = false;
+        --live_count_;
+    }
+    key_index_.erase(slot.key);
+    slot.value = lldb::SBValue();
+    slot.origin = VariableOrigin();
+    slot.has_fingerprint = false;
+    slot.has_previous_fingerprint = false;
+    slot.in_use = false;
+    ++slot.generation;
+    if (slot.generation == 0) {
+        slot.generation = 1;
+    }
+    slot.next_free = free_head_;
+    free_head_ = slot_index;
+    --in_use_;
+}
+
+} // namespace Cangjie::Debugger
@@ -0,0 +1,166 @@
+/*
+ * Copyright 2025 LinQingYing. and contributors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * The use of this source code is governed by the Apache License 2.0,
+ * which allows users to freely use, modify, and distribute the code,
+ * provided they adhere to the terms of the license.
+ *
+ * The software is provided "as-is", and the authors are not responsible for
+ * any damages or issues arising from its use.
+ *
+ */
+
+#include "cangjie/debugger/VariablePathParser.h"
+
+namespace Cangjie::Debugger {
+
+namespace {
+
+bool IsSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+bool IsDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+// 非 ASCII 字节按标识符字符处理，以接受 UTF-8 编码的 Unicode 标识符
+bool IsIdentifierStart(char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_' || static_cast<unsigned char>(c) >= 0x80;
+}
+
+bool IsIdentifierChar(char c) {
+    return IsIdentifierStart(c) || IsDigit(c);
+}
+
+class Cursor {
+public:
+    explicit Cursor(const std::string& text) : text_(text) {
+    }
+
+    void SkipSpaces() {
+        while (pos_ < text_.size() && IsSpace(text_[pos_])) {
+            ++pos_;
+        }
+    }
+
+    [[nodiscard]] bool AtEnd() const {
+        return pos_ >= text_.size();
+    }
+
+    [[nodiscard]] char Peek(size_t ahead = 0) const {
+        return pos_ + ahead < text_.size() ? text_[pos_ + ahead] : '\0';
+    }
+
+    void Advance(size_t count = 1) {
+        pos_ += count;
+    }
+
+    /**
+     * @brief 读取一个标识符并追加到 out
+     */
+    bool ReadIdentifier(std::string& out) {
+        SkipSpaces();
+        if (!IsIdentifierStart(Peek())) {
+            return false;
+        }
+        const size_t start = pos_;
+        while (!AtEnd() && IsIdentifierChar(text_[pos_])) {
+            ++pos_;
+        }
+        out.append(text_, start, pos_ - start);
+        return true;
+    }
+
+    /**
+     * @brief 读取一个十进制下标并追加到 out
+     */
+    bool ReadIndex(std::string& out) {
+        SkipSpaces();
+        if (!IsDigit(Peek())) {
+            return false;
+        }
+        const size_t start = pos_;
+        while (!AtEnd() && IsDigit(text_[pos_])) {
+            ++pos_;
+        }
+        out.append(text_, start, pos_ - start);
+        return true;
+    }
+
+private:
+    const std::string& text_;
+    size_t pos_ = 0;
+};
+
+} // namespace
+
+std::optional<VariablePath> VariablePathParser::Parse(const std::string& expression) {
+    Cursor cursor(expression);
+    VariablePath result;
+
+    cursor.SkipSpaces();
+    while (cursor.Peek() == '*') {
+        result.path.push_back('*');
+        cursor.Advance();
+        cursor.SkipSpaces();
+    }
+    const size_t root_start = result.path.size();
+    if (!cursor.ReadIdentifier(result.path)) {
+        return std::nullopt;
+    }
+    result.root = result.path.substr(root_start);
+    bool has_suffix = false;
+
+    while (true) {
+        cursor.SkipSpaces();
+        if (cursor.AtEnd()) {
+            break;
+        }
+        if (cursor.Peek() == '.') {
+            cursor.Advance();
+            result.path.push_back('.');
+            if (!cursor.ReadIdentifier(result.path)) {
+                return std::nullopt;
+            }
+        } else if (cursor.Peek() == '-' && cursor.Peek(1) == '>') {
+            cursor.Advance(2);
+            result.path.append("->");
+            if (!cursor.ReadIdentifier(result.path)) {
+                return std::nullopt;
+            }
+        } else if (cursor.Peek() == '[') {
+            cursor.Advance();
+            result.path.push_back('[');
+            if (!cursor.ReadIndex(result.path)) {
+                return std::nullopt;
+            }
+            cursor.SkipSpaces();
+            if (cursor.Peek() != ']') {
+                return std::nullopt;
+            }
+            cursor.Advance();
+            result.path.push_back(']');
+        } else {
+            return std::nullopt;
+        }
+        has_suffix = true;
+    }
+
+    result.is_identifier = !has_suffix && root_start == 0;
+    return result;
+}
+
+} // namespace Cangjie::Debugger
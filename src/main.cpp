@@ -42,7 +42,7 @@ int main(int argc, char** argv) {
     std::cout << std::endl;
 
     if (argc < 2) {
-        std::cerr << "Usage: " << argv[0] << " <port>" << std::endl;
+        std::cerr << "Usage: " << argv[0] << " <port> [max_live_variables]" << std::endl;
         std::cerr << "Example: " << argv[0] << " 8080" << std::endl;
         LOG_ERROR("No port number provided");
         Cangjie::Debugger::Logger::Shutdown();
@@ -82,6 +82,16 @@ int main(int argc, char** argv) {
     Cangjie::Debugger::DebuggerClient debugger_client(tcp_client);
     std::cout << "LLDB initialized" << std::endl;
 
+    // 可选：变量存储预算（同时持有的最大变量数量，0 表示不限制）
+    if (argc >= 3) {
+        try {
+            debugger_client.SetMaxLiveVariables(static_cast<size_t>(std::stoull(argv[2])));
+        } catch (const std::exception& e) {
+            std::cerr << "Warning: ignoring invalid max_live_variables '" << argv[2] << "'" << std::endl;
+            LOG_WARNING("Failed to parse max_live_variables: " + std::string(e.what()));
+        }
+    }
+
     try {
         std::cout << "Entering message loop..." << std::endl;
         debugger_client.RunMessageLoop();
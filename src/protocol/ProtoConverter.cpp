@@ -28,6 +28,19 @@
 
 namespace Cangjie {
     namespace Debugger {
+        namespace {
+            /**
+             * @brief 判断值是否可能有摘要：绑定了摘要提供器，或不是内置标量类型
+             */
+            bool MightHaveSummary(lldb::SBValue &sb_value) {
+                if (sb_value.GetTypeSummary().IsValid()) {
+                    return true;
+                }
+                const uint32_t flags = sb_value.GetType().GetCanonicalType().GetTypeFlags();
+                return (flags & lldb::eTypeIsBuiltIn) == 0 || (flags & lldb::eTypeIsScalar) == 0;
+            }
+        }
+
         // ============================================================================
         // 基础类型转换
         // ============================================================================
@@ -56,13 +69,23 @@ namespace Cangjie {
             lldbprotobuf::HashAlgorithm hash_algorithm,
             const std::string &hash_value) {
             lldbprotobuf::SourceLocation location;
-            location.set_file_path(file_path);
-            location.set_line(line);
-            *location.mutable_hash() = CreateHash(hash_algorithm, hash_value);
-
+            FillSourceLocation(&location, file_path, line, hash_algorithm, hash_value);
             return location;
         }
 
+        void ProtoConverter::FillSourceLocation(
+            lldbprotobuf::SourceLocation *location,
+            const std::string &file_path,
+            uint32_t line,
+            lldbprotobuf::HashAlgorithm hash_algorithm,
+            const std::string &hash_value) {
+            location->set_file_path(file_path);
+            location->set_line(line);
+            lldbprotobuf::Hash *hash = location->mutable_hash();
+            hash->set_hash_algorithm(hash_algorithm);
+            hash->set_hash_value(hash_value);
+        }
+
 
         // ============================================================================
         // 线程和执行状态转换
@@ -102,23 +125,28 @@ namespace Cangjie {
         lldbprotobuf::ThreadStopInfo ProtoConverter::CreateThreadStopInfo(
             lldb::SBThread &sb_thread) {
             lldbprotobuf::ThreadStopInfo stop_info;
+            FillThreadStopInfo(&stop_info, sb_thread);
+            return stop_info;
+        }
 
+        void ProtoConverter::FillThreadStopInfo(lldbprotobuf::ThreadStopInfo *stop_info,
+                                                lldb::SBThread &sb_thread) {
             // 获取停止原因
             lldb::StopReason lldb_reason = sb_thread.GetStopReason();
             lldbprotobuf::StopReason reason = CreateStopReason(lldb_reason);
-            stop_info.set_reason(reason);
+            stop_info->set_reason(reason);
 
             // 获取停止描述
             char stop_desc[256];
             size_t desc_len = sb_thread.GetStopDescription(stop_desc, sizeof(stop_desc));
             std::string description = std::string(stop_desc, desc_len);
-            stop_info.set_description(description);
+            stop_info->set_description(description);
 
             // 根据停止原因填充详细信息 - 所有值都从LLDB API获取
             switch (lldb_reason) {
                 case lldb::eStopReasonBreakpoint: {
                     lldbprotobuf::BreakpointStopInfo* breakpoint_info =
-                        stop_info.mutable_breakpoint_info();
+                        stop_info->mutable_breakpoint_info();
 
                     // 从LLDB API获取断点ID
                     uint64_t bp_id = sb_thread.GetStopReasonDataAtIndex(0);
@@ -173,7 +201,7 @@ namespace Cangjie {
 
                 case lldb::eStopReasonWatchpoint: {
                     lldbprotobuf::WatchpointStopInfo* watchpoint_info =
-                        stop_info.mutable_watchpoint_info();
+                        stop_info->mutable_watchpoint_info();
 
                     // 从LLDB API获取观察点信息
                     uint64_t wp_id = sb_thread.GetStopReasonDataAtIndex(0);
@@ -208,7 +236,7 @@ namespace Cangjie {
 
                 case lldb::eStopReasonSignal: {
                     lldbprotobuf::SignalStopInfo* signal_info =
-                        stop_info.mutable_signal_info();
+                        stop_info->mutable_signal_info();
 
                     // 从LLDB API获取信号信息
                     int32_t signal_num = static_cast<int32_t>(sb_thread.GetStopReasonDataAtIndex(0));
@@ -221,7 +249,7 @@ namespace Cangjie {
 
                 case lldb::eStopReasonException: {
                     lldbprotobuf::ExceptionStopInfo* exception_info =
-                        stop_info.mutable_exception_stop_info();
+                        stop_info->mutable_exception_stop_info();
 
                     // 从LLDB API获取异常信息
                     uint64_t exception_addr = sb_thread.GetStopReasonDataAtIndex(0);
@@ -275,7 +303,7 @@ namespace Cangjie {
 
                 case lldb::eStopReasonTrace: {
                     lldbprotobuf::StepStopInfo* step_info =
-                        stop_info.mutable_step_info();
+                        stop_info->mutable_step_info();
 
                     // 获取当前源代码位置
                     lldb::SBFrame frame = sb_thread.GetFrameAtIndex(0);
@@ -326,7 +354,7 @@ namespace Cangjie {
 
                 case lldb::eStopReasonPlanComplete: {
                     lldbprotobuf::PlanCompleteStopInfo* plan_info =
-                        stop_info.mutable_plan_complete_info();
+                        stop_info->mutable_plan_complete_info();
 
                     // 从LLDB获取计划完成信息
                     plan_info->set_result_description(description);
@@ -363,7 +391,7 @@ namespace Cangjie {
 
                 case lldb::eStopReasonThreadExiting: {
                     lldbprotobuf::ThreadExitStopInfo* exit_info =
-                        stop_info.mutable_thread_exit_info();
+                        stop_info->mutable_thread_exit_info();
 
                     // 从LLDB API获取线程退出信息
                     int32_t exit_code = static_cast<int32_t>(sb_thread.GetStopReasonDataAtIndex(0));
@@ -387,7 +415,7 @@ namespace Cangjie {
 
                 case lldb::eStopReasonInstrumentation: {
                     lldbprotobuf::InstrumentationStopInfo* instr_info =
-                        stop_info.mutable_instrumentation_info();
+                        stop_info->mutable_instrumentation_info();
 
                     // 从LLDB API获取工具化事件信息
                     instr_info->set_event_data(description);
@@ -420,8 +448,6 @@ namespace Cangjie {
                     // 对于其他停止原因，不设置详细的stop_details
                     break;
             }
-
-            return stop_info;
         }
 
         // 辅助函数：获取信号名称
@@ -473,130 +499,171 @@ namespace Cangjie {
         lldbprotobuf::Thread ProtoConverter::CreateThread(lldb::SBThread &sb_thread) {
             // 创建 protobuf Thread 对象
             lldbprotobuf::Thread thread;
-            thread.set_index(sb_thread.GetIndexID());
-            *thread.mutable_thread_id() = CreateId(sb_thread.GetThreadID());
+            FillThread(&thread, sb_thread);
+            return thread;
+        }
 
-            thread.set_name(sb_thread.GetName() ? sb_thread.GetName() : "");
-            thread.set_is_frozen(false);
+        void ProtoConverter::FillThread(lldbprotobuf::Thread *thread, lldb::SBThread &sb_thread) {
+            thread->set_index(sb_thread.GetIndexID());
+            thread->mutable_thread_id()->set_id(static_cast<int64_t>(sb_thread.GetThreadID()));
 
-            // 使用新的 CreateThreadStopInfo 方法直接从 SBThread 创建详细的停止信息
-            *thread.mutable_stop_info() = CreateThreadStopInfo(sb_thread);
+            thread->set_name(sb_thread.GetName() ? sb_thread.GetName() : "");
+            thread->set_is_frozen(false);
 
-            return thread;
+            // 直接在目标消息内填充详细的停止信息
+            FillThreadStopInfo(thread->mutable_stop_info(), sb_thread);
         }
 
         lldbprotobuf::Frame ProtoConverter::CreateFrame(lldb::SBFrame &sb_frame) {
             lldbprotobuf::Frame frame;
+            FillFrame(&frame, sb_frame);
+            return frame;
+        }
 
-
-            frame.set_index(sb_frame.GetFrameID());
-            *frame.mutable_id() = CreateId(sb_frame.GetFrameID());
+        void ProtoConverter::FillFrame(lldbprotobuf::Frame *frame, lldb::SBFrame &sb_frame) {
+            frame->set_index(sb_frame.GetFrameID());
+            frame->mutable_id()->set_id(sb_frame.GetFrameID());
             // 设置函数名
             if (const char *function_name = sb_frame.GetFunctionName()) {
-                frame.set_function_name(function_name);
+                frame->set_function_name(function_name);
             }
             //设置模块名
             lldb::SBModule sb_module = sb_frame.GetModule();
             if (sb_module.IsValid()) {
-                frame.set_module(sb_module.GetFileSpec().GetFilename());
+                frame->set_module(sb_module.GetFileSpec().GetFilename());
             }
 
             // 设置程序计数器
-            frame.set_program_counter(sb_frame.GetPC());
+            frame->set_program_counter(sb_frame.GetPC());
 
             // 创建源码位置信息
-            lldbprotobuf::SourceLocation location;
+            lldbprotobuf::SourceLocation *location = frame->mutable_location();
             const lldb::SBLineEntry line_entry = sb_frame.GetLineEntry();
             if (line_entry.IsValid()) {
                 lldb::SBFileSpec file_spec = line_entry.GetFileSpec();
                 if (file_spec.IsValid()) {
                     char file_path[1024];
                     file_spec.GetPath(file_path, sizeof(file_path));
-                    location = CreateSourceLocation(file_path, line_entry.GetLine());
+                    FillSourceLocation(location, file_path, line_entry.GetLine());
                 }
             }
-
-            *frame.mutable_location() = location;
-            return frame;
         }
 
         lldbprotobuf::Type ProtoConverter::CreateType(std::string type_name,
                                                       std::optional<lldbprotobuf::TypeKind> type_kind,
                                                       std::string display_type) {
             lldbprotobuf::Type type;
+            FillType(&type, type_name, type_kind, display_type);
+            return type;
+        }
 
+        void ProtoConverter::FillType(lldbprotobuf::Type *type,
+                                      const std::string &type_name,
+                                      std::optional<lldbprotobuf::TypeKind> type_kind,
+                                      const std::string &display_type) {
             // 设置类型名称
             if (!type_name.empty()) {
-                type.set_type_name(type_name);
+                type->set_type_name(type_name);
             } else {
-                type.set_type_name("<unknown>");
+                type->set_type_name("<unknown>");
             }
 
             // 设置显示类型名称
             if (!display_type.empty()) {
-                type.set_display_type(display_type);
+                type->set_display_type(display_type);
             } else {
                 // 如果没有显示类型名称，尝试使用类型名称
-                type.set_display_type(type.type_name());
+                type->set_display_type(type->type_name());
             }
 
             // 设置类型种类（处理可能为空的情况）
             if (type_kind.has_value()) {
-                type.set_type_kind(type_kind.value());
+                type->set_type_kind(type_kind.value());
             }
-
-            return type;
         }
 
         lldbprotobuf::Type ProtoConverter::CreateType(lldb::SBType &sb_type) {
             lldbprotobuf::Type type;
+            FillType(&type, sb_type);
+            return type;
+        }
 
+        void ProtoConverter::FillType(lldbprotobuf::Type *type, lldb::SBType &sb_type) {
             // 设置类型名称
             if (const char *type_name = sb_type.GetName()) {
-                type.set_type_name(type_name);
+                type->set_type_name(type_name);
             } else {
-                type.set_type_name("<unknown>");
+                type->set_type_name("<unknown>");
             }
 
             // 设置显示类型名称（使用更友好的显示名称）
             if (const char *display_name = sb_type.GetDisplayTypeName()) {
-                type.set_display_type(display_name);
+                type->set_display_type(display_name);
             } else {
                 // 如果没有显示类型名称，尝试使用类型名称
-                type.set_display_type(type.type_name());
+                type->set_display_type(type->type_name());
             }
 
             // 使用独立的转换方法
             lldb::TypeClass type_class = sb_type.GetTypeClass();
-            type.set_type_kind(ConvertTypeKind(type_class));
-
-            return type;
+            type->set_type_kind(ConvertTypeKind(type_class));
         }
 
-        lldbprotobuf::Variable ProtoConverter::CreateVariable(lldb::SBValue &sb_value, uint64_t variable_id) {
+        lldbprotobuf::Variable ProtoConverter::CreateVariable(lldb::SBValue &sb_value, uint64_t variable_id,
+                                                              TypeCache *type_cache) {
             lldbprotobuf::Variable variable;
-            variable.mutable_id()->set_id(variable_id);
+            FillVariable(&variable, sb_value, variable_id, type_cache);
+            return variable;
+        }
+
+        void ProtoConverter::FillVariableType(lldbprotobuf::Type *type, lldb::SBValue &sb_value,
+                                              TypeCache *type_cache) {
+            // 直接使用值自身携带的类型，无需再按名称在整个目标中查找
+            lldb::SBType sb_type = sb_value.GetType();
+            const char *type_name = sb_value.GetTypeName();
+
+            std::string key;
+            if (type_cache != nullptr && type_name != nullptr && sb_type.IsValid()) {
+                lldb::SBModule module = sb_type.GetModule();
+                key = TypeCache::MakeKey(module.IsValid() ? module.GetUUIDString() : nullptr, type_name);
+                if (type_cache->Lookup(key, type)) {
+                    return;
+                }
+            }
+
+            if (sb_type.IsValid()) {
+                FillType(type, sb_type);
+            } else {
+                FillType(type,
+                    type_name ? type_name : "",
+                    std::nullopt,
+                    sb_value.GetDisplayTypeName() ? sb_value.GetDisplayTypeName() : "");
+            }
+
+            if (!key.empty()) {
+                type_cache->Store(key, *type);
+            }
+        }
+
+        void ProtoConverter::FillVariable(lldbprotobuf::Variable *variable,
+                                          lldb::SBValue &sb_value,
+                                          uint64_t variable_id,
+                                          TypeCache *type_cache) {
+            variable->mutable_id()->set_id(variable_id);
             // 设置变量名称
             if (const char *name = sb_value.GetName()) {
-                variable.set_name(name);
+                variable->set_name(name);
             } else {
-                variable.set_name("<unnamed>");
+                variable->set_name("<unnamed>");
             }
 
 
             // 安全地设置变量类型
             try {
-                lldb::SBType sb_type = sb_value.GetTarget().FindFirstType(sb_value.GetTypeName());
-                if (sb_type.IsValid()) {
-                    *variable.mutable_type() = CreateType(sb_type);
-                } else {
-                    *variable.mutable_type() = CreateType(
-                        sb_value.GetTypeName() ? sb_value.GetTypeName() : "",
-                        std::nullopt,
-                        sb_value.GetDisplayTypeName() ? sb_value.GetDisplayTypeName() : "");
-                }
+                FillVariableType(variable->mutable_type(), sb_value, type_cache);
             } catch (...) {
-                *variable.mutable_type() = CreateType(
+                variable->clear_type();
+                FillType(variable->mutable_type(),
                     sb_value.GetTypeName() ? sb_value.GetTypeName() : "<error_type>",
                     std::nullopt,
                     sb_value.GetDisplayTypeName() ? sb_value.GetDisplayTypeName() : "");
@@ -610,25 +677,24 @@ namespace Cangjie {
                 // 如果获取值类型失败，使用默认值
                 value_type = lldb::eValueTypeInvalid;
             }
-            variable.set_value_kind(ConvertValueKind(value_type));
+            variable->set_value_kind(ConvertValueKind(value_type));
 
             // 设置是否有子变量（对应 SBValue::MightHaveChildren()）
             try {
                 bool has_children = sb_value.MightHaveChildren();
-                variable.set_has_children(has_children);
+                variable->set_has_children(has_children);
             } catch (...) {
                 // 如果获取子变量信息失败，默认为 false
-                variable.set_has_children(false);
+                variable->set_has_children(false);
             }
 
             try {
                 uint64_t addr = sb_value.GetLoadAddress();
-                variable.set_address(addr);
+                variable->set_address(addr);
             } catch (...) {
-                variable.set_address(0);
+                variable->set_address(0);
             }
 
-            return variable;
         }
 
         lldbprotobuf::Value ProtoConverter::CreateValue(lldb::SBValue &sb_value, uint64_t variable_id) {
@@ -637,7 +703,8 @@ namespace Cangjie {
 
         lldbprotobuf::Value ProtoConverter::CreateValue(lldb::SBValue &sb_value,
                                                         uint64_t variable_id,
-                                                        uint32_t max_string_length) {
+                                                        uint32_t max_string_length,
+                                                        bool include_summary) {
             lldbprotobuf::Value value;
 
             value.mutable_variable_id()->set_id(variable_id);
@@ -654,8 +721,14 @@ namespace Cangjie {
                 value.set_value("");
             }
 
-            // 设置值的摘要（适用于复杂对象）
-            if (const char *summary = sb_value.GetSummary()) {
+            // 设置值的摘要（适用于复杂对象）；摘要提供器可能很慢，调用方可要求延迟计算
+            // 内置标量没有摘要可延迟，直接返回空摘要，避免显示占位符并引发多余的 GetSummaries 请求
+            if (!include_summary && MightHaveSummary(sb_value)) {
+                value.set_summary("...");
+                value.set_summary_deferred(true);
+            } else if (!include_summary) {
+                value.set_summary("");
+            } else if (const char *summary = sb_value.GetSummary()) {
                 std::string summary_str = summary;
                 // 限制摘要长度
                 if (summary_str.length() > max_string_length) {
@@ -828,11 +901,18 @@ namespace Cangjie {
             bool success,
             const std::string &error_message) {
             lldbprotobuf::Status status;
-            status.set_success(success);
+            FillResponseStatus(&status, success, error_message);
+            return status;
+        }
+
+        void ProtoConverter::FillResponseStatus(
+            lldbprotobuf::Status *status,
+            bool success,
+            const std::string &error_message) {
+            status->set_success(success);
             if (!error_message.empty()) {
-                status.set_message(error_message);
+                status->set_message(error_message);
             }
-            return status;
         }
 
         lldbprotobuf::Id ProtoConverter::CreateId(const int64_t id) {
@@ -925,6 +1005,26 @@ namespace Cangjie {
             return response;
         }
 
+        lldbprotobuf::ConfigureStopSnapshotResponse ProtoConverter::CreateConfigureStopSnapshotResponse(
+            bool success,
+            uint32_t max_frames,
+            uint32_t max_locals,
+            const std::string &error_message) {
+            lldbprotobuf::ConfigureStopSnapshotResponse response;
+            FillResponseStatus(response.mutable_status(), success, error_message);
+            response.set_max_frames(max_frames);
+            response.set_max_locals(max_locals);
+            return response;
+        }
+
+        lldbprotobuf::ConfigureStringInternResponse ProtoConverter::CreateConfigureStringInternResponse(
+            bool success,
+            const std::string &error_message) {
+            lldbprotobuf::ConfigureStringInternResponse response;
+            FillResponseStatus(response.mutable_status(), success, error_message);
+            return response;
+        }
+
         // ========================================================================
         // 进程状态变更事件创建
         // ========================================================================